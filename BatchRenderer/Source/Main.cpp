@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    FirstEQBatchRenderer: applies a FirstEQ state (or a set of parameter
+    values) to WAV, AIFF and FLAC files without a host or an editor, running
+    the same processor the plugin uses. Files are rendered in parallel, and
+    each one is streamed through in fixed-size blocks, so memory use doesn't
+    grow with file length.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    struct RenderSettings
+    {
+        juce::MemoryBlock state;                 // from --state, applied first
+        juce::StringPairArray parameterValues;   // from --set, applied on top of the state
+        juce::File outputDirectory;
+        int blockSize { 4096 };
+        bool verify { false };                   // from --verify
+    };
+    
+    juce::CriticalSection logLock;
+    
+    void log(const juce::String& message){
+        const juce::ScopedLock sl(logLock);
+        std::cout << message << std::endl;
+    }
+    
+    void printUsage(){
+        std::cout << "Usage: FirstEQBatchRenderer --output <dir> [options] <file or directory>...\n"
+                     "\n"
+                     "  --state <file>      FirstEQ state, as saved by the plugin\n"
+                     "  --set <ID=value>    parameter value, e.g. \"Peak Gain=3\"; may be repeated\n"
+                     "  --threads <n>       number of files rendered at once (default: one per core)\n"
+                     "  --block-size <n>    samples per processBlock call (default: 4096)\n"
+                     "  --verify            render each file twice and fail if the two differ\n"
+                  << std::endl;
+    }
+    
+    void applySettings(FirstEQAudioProcessor& processor, const RenderSettings& settings){
+        if (settings.state.getSize() > 0)
+            processor.setStateInformation(settings.state.getData(), static_cast<int>(settings.state.getSize()));
+        
+        for (auto& parameterID : settings.parameterValues.getAllKeys()){
+            if (auto* param = processor.apvts.getParameter(parameterID))
+                param->setValueNotifyingHost(param->convertTo0to1(settings.parameterValues[parameterID].getFloatValue()));
+            else
+                log("Unknown parameter: " + parameterID);
+        }
+    }
+    
+    std::unique_ptr<juce::AudioFormatReader> createReader(juce::AudioFormatManager& formats, const juce::File& file){
+        // WAV and AIFF can be memory-mapped, so the file is paged in by the OS rather than copied
+        // into our own buffers. Anything else is read through a buffered stream.
+        if (auto* format = formats.findFormatForFileExtension(file.getFileExtension())){
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+            
+            if (mapped != nullptr && mapped->mapEntireFile())
+                return mapped;
+        }
+        
+        return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+    }
+    
+    juce::AudioProcessor::BusesLayout makeLayout(int numChannels){
+        auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        
+        if (channelSet.isDisabled())
+            channelSet = juce::AudioChannelSet::discreteChannels(numChannels);
+        
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channelSet);
+        layout.outputBuses.add(channelSet);
+        return layout;
+    }
+    
+    /** Renders one file into outputFile, returning an error message on failure. */
+    juce::String renderFile(const juce::File& input, const juce::File& outputFile, const RenderSettings& settings){
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        
+        auto reader = createReader(formats, input);
+        auto* format = formats.findFormatForFileExtension(input.getFileExtension());
+        
+        if (reader == nullptr || format == nullptr)
+            return "can't read this file";
+        
+        auto numChannels = static_cast<int>(reader->numChannels);
+        
+        outputFile.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream(outputFile.createOutputStream());
+        
+        if (stream == nullptr)
+            return "can't create " + outputFile.getFullPathName();
+        
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), reader->sampleRate, static_cast<unsigned int>(numChannels),
+                                                                                static_cast<int>(reader->bitsPerSample), reader->metadataValues, 0));
+        
+        if (writer == nullptr)
+            return "can't write this format";
+        
+        stream.release(); // now owned by the writer
+        
+        FirstEQAudioProcessor processor;
+        
+        if (! processor.setBusesLayout(makeLayout(numChannels)))
+            return "unsupported channel count";
+        
+        processor.setNonRealtime(true);
+        applySettings(processor, settings);
+        // As a host would, so getSampleRate() is set before the first block.
+        processor.setRateAndBufferSizeDetails(reader->sampleRate, settings.blockSize);
+        processor.prepareToPlay(reader->sampleRate, settings.blockSize);
+        
+        juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+        
+        // Any latency is trimmed from the start and flushed out at the end, so the output lines up with the input.
+        auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+        auto length = reader->lengthInSamples;
+        juce::int64 readPosition = 0, written = 0;
+        
+        while (written < length){
+            auto numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(settings.blockSize), length + latency - readPosition));
+            buffer.setSize(numChannels, numSamples, false, false, true);
+            
+            // Reading past the end of the file fills the buffer with silence.
+            reader->read(&buffer, 0, numSamples, readPosition, true, true);
+            processor.processBlock(buffer, midi);
+            
+            auto skip = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numSamples), latency - readPosition));
+            auto numToWrite = static_cast<int>(juce::jmin(static_cast<juce::int64>(numSamples - skip), length - written));
+            
+            if (! writer->writeFromAudioSampleBuffer(buffer, skip, numToWrite))
+                return "write failed";
+            
+            readPosition += numSamples;
+            written += numToWrite;
+        }
+        
+        processor.releaseResources();
+        return {};
+    }
+    
+    /** Renders one file into the output directory and, with --verify, renders it again and compares the two.
+        A render must come out the same every time: nothing in it may depend on when a background thread
+        gets to something, such as loading the linear-phase FIR.
+    */
+    juce::String renderFile(const juce::File& input, const RenderSettings& settings){
+        auto outputFile = settings.outputDirectory.getChildFile(input.getFileName());
+        
+        if (outputFile == input)
+            return "the output would overwrite the input";
+        
+        auto error = renderFile(input, outputFile, settings);
+        
+        if (error.isNotEmpty() || ! settings.verify)
+            return error;
+        
+        // Same extension as the output, so it's written in the same format.
+        juce::TemporaryFile secondRender(outputFile);
+        error = renderFile(input, secondRender.getFile(), settings);
+        
+        if (error.isNotEmpty())
+            return "second render: " + error;
+        
+        if (! secondRender.getFile().hasIdenticalContentTo(outputFile))
+            return "a second render differs from the first";
+        
+        return {};
+    }
+    
+    juce::Array<juce::File> findInputFiles(const juce::StringArray& paths){
+        juce::Array<juce::File> files;
+        
+        for (auto& path : paths){
+            auto file = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+            
+            if (file.isDirectory())
+                files.addArray(file.findChildFiles(juce::File::findFiles, true, "*.wav;*.aif;*.aiff;*.flac"));
+            else if (file.existsAsFile())
+                files.add(file);
+            else
+                log("Not found: " + path);
+        }
+        
+        return files;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor's parameters and value tree expect a message manager to exist.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    RenderSettings settings;
+    juce::StringArray inputPaths;
+    auto numThreads = juce::SystemStats::getNumCpus();
+    
+    for (int i = 1; i < argc; ++i){
+        juce::String arg(argv[i]);
+        auto hasValue = i + 1 < argc;
+        
+        if (arg == "--state" && hasValue){
+            auto stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+            
+            if (! stateFile.loadFileAsData(settings.state)){
+                log("Can't read state file: " + stateFile.getFullPathName());
+                return 1;
+            }
+        }
+        else if (arg == "--set" && hasValue){
+            juce::String assignment(argv[++i]);
+            settings.parameterValues.set(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                                         assignment.fromFirstOccurrenceOf("=", false, false).trim());
+        }
+        else if (arg == "--output" && hasValue)
+            settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (arg == "--threads" && hasValue)
+            numThreads = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--block-size" && hasValue)
+            settings.blockSize = juce::jlimit(1, 65536, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--verify")
+            settings.verify = true;
+        else if (arg.startsWith("--")){
+            printUsage();
+            return 1;
+        }
+        else
+            inputPaths.add(arg);
+    }
+    
+    if (settings.outputDirectory == juce::File() || inputPaths.isEmpty()){
+        printUsage();
+        return 1;
+    }
+    
+    if (! settings.outputDirectory.createDirectory()){
+        log("Can't create output directory: " + settings.outputDirectory.getFullPathName());
+        return 1;
+    }
+    
+    auto inputs = findInputFiles(inputPaths);
+    std::atomic<int> numFailed { 0 };
+    
+    {
+        juce::ThreadPool pool(numThreads);
+        
+        for (auto& input : inputs){
+            pool.addJob([input, &settings, &numFailed]{
+                auto error = renderFile(input, settings);
+                
+                if (error.isNotEmpty()){
+                    ++numFailed;
+                    log("FAILED " + input.getFullPathName() + ": " + error);
+                }
+                else{
+                    log("done   " + input.getFullPathName());
+                }
+            });
+        }
+        
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+    
+    log(juce::String(inputs.size() - numFailed.load()) + " of " + juce::String(inputs.size()) + " files rendered");
+    
+    return numFailed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,351 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    FirstEQBenchmark: times FirstEQAudioProcessor::processBlock over a grid of
+    block sizes, sample rates, filter slopes, channel counts and automation
+    rates, and times the filter-design functions on their own. Results are
+    written as CSV, one measurement per row:
+
+        benchmark,block_size,sample_rate,slope,channels,automation_hz,metric,value
+
+    "ns_per_sample" is nanoseconds per sample per channel (the median of the
+    repetitions); "ns_per_call" is nanoseconds per design call; "hit_rate" is the
+    share of the shared coefficient cache's lookups that found their band.
+    Columns that don't apply to a row are left empty.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        juce::Array<int> blockSizes { 1, 16, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+        juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0, 192000.0 };
+        juce::Array<int> slopes { Slope_12, Slope_24, Slope_36, Slope_48 };
+        juce::Array<int> channelCounts { 1, 2, 6, 8 };
+        juce::Array<double> automationRates { 0.0, 10.0, 100.0, 1000.0 };   // parameter changes per second
+        
+        int repetitions { 5 };
+        int designCalls { 10000 };
+        int stateInstances { 500 };
+        
+        // Applies to every processBlock point. Outside linked mode the peak runs on the first channel only.
+        StereoMode stereoMode { StereoMode_Linked };
+    };
+    
+    // The --stereo-mode names, in StereoMode order.
+    const juce::StringArray stereoModeNames { "linked", "mid-side", "dual-mono" };
+    
+    double ticksToNanoseconds(juce::int64 ticks){
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9;
+    }
+    
+    double median(std::vector<double> values){
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+    
+    juce::AudioProcessor::BusesLayout makeLayout(int numChannels){
+        auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        
+        if (channelSet.isDisabled())
+            channelSet = juce::AudioChannelSet::discreteChannels(numChannels);
+        
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channelSet);
+        layout.outputBuses.add(channelSet);
+        return layout;
+    }
+    
+    void setParameter(FirstEQAudioProcessor& processor, const juce::String& parameterID, float value){
+        if (auto* param = processor.apvts.getParameter(parameterID))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+    
+    /** Median ns per sample per channel for one point of the processBlock grid. */
+    double timeProcessBlock(int blockSize, double sampleRate, int slope, int numChannels, double automationRate, int repetitions, StereoMode stereoMode){
+        FirstEQAudioProcessor processor;
+        processor.setBusesLayout(makeLayout(numChannels));
+        
+        setParameter(processor, "LowCut Freq", 80.f);
+        setParameter(processor, "HighCut Freq", 12000.f);
+        setParameter(processor, "Peak Gain", 6.f);
+        setParameter(processor, "LowCut Slope", static_cast<float>(slope));
+        setParameter(processor, "HighCut Slope", static_cast<float>(slope));
+        setParameter(processor, "Stereo Mode", static_cast<float>(stereoMode));
+        setParameter(processor, "Peak Channel", static_cast<float>(stereoMode == StereoMode_Linked ? BandChannel_Both : BandChannel_First));
+        
+        // As a host would, so getSampleRate() is set before the first block.
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        
+        // Each repetition runs a fresh stretch of noise through the processor in place, block by block,
+        // so the signal never passes through the filters more than once per repetition.
+        auto numSamples = juce::jmax(1 << 16, blockSize * 8);
+        juce::AudioBuffer<float> source(numChannels, numSamples);
+        juce::MidiBuffer midi;
+        juce::Random random;
+        
+        auto samplesPerChange = automationRate > 0.0 ? juce::jmax(1, juce::roundToInt(sampleRate / automationRate)) : 0;
+        auto nextChange = samplesPerChange;
+        auto gainToggle = false;
+        
+        std::vector<double> results;
+        
+        for (int repetition = 0; repetition <= repetitions; ++repetition){
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    source.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+            
+            auto start = juce::Time::getHighResolutionTicks();
+            
+            for (int offset = 0; offset < numSamples; offset += blockSize){
+                auto numThisTime = juce::jmin(blockSize, numSamples - offset);
+                
+                // Like a host would, parameter changes land between blocks on the audio thread.
+                if (samplesPerChange > 0 && offset >= nextChange){
+                    gainToggle = ! gainToggle;
+                    setParameter(processor, "Peak Gain", gainToggle ? -6.f : 6.f);
+                    nextChange += samplesPerChange;
+                }
+                
+                juce::AudioBuffer<float> block(source.getArrayOfWritePointers(), numChannels, offset, numThisTime);
+                processor.processBlock(block, midi);
+            }
+            
+            auto elapsed = juce::Time::getHighResolutionTicks() - start;
+            nextChange -= numSamples;
+            
+            // The first pass only warms up caches and lets the designer thread settle.
+            if (repetition > 0)
+                results.push_back(ticksToNanoseconds(elapsed) / (static_cast<double>(numSamples) * numChannels));
+        }
+        
+        processor.releaseResources();
+        return median(results);
+    }
+    
+    // Written after each design loop so the optimiser can't discard the work being timed.
+    volatile double designSink = 0.0;
+    
+    /** Mean ns per call of a design function, sweeping the frequency so no two calls are identical. */
+    template <typename DesignFunction>
+    double timeDesign(DesignFunction&& design, int numCalls){
+        ChainSettings settings;
+        settings.bands[0].type = BandType_Bell;
+        double sink = 0.0;
+        
+        auto start = juce::Time::getHighResolutionTicks();
+        
+        for (int i = 0; i < numCalls; ++i){
+            auto freq = 20.f + static_cast<float>(i % 1000) * 19.f;
+            settings.lowCutFreq = settings.highCutFreq = settings.bands[0].frequency = freq;
+            sink += design(settings);
+        }
+        
+        auto elapsed = juce::Time::getHighResolutionTicks() - start;
+        
+        designSink = sink;
+        return ticksToNanoseconds(elapsed) / numCalls;
+    }
+    
+    void runDesignBenchmarks(const BenchmarkOptions& options, juce::OutputStream& out){
+        // The instances' shared cache, held here so its hit rate covers every rate's sweep.
+        juce::SharedResourcePointer<CoefficientCache> cache;
+        
+        for (auto sampleRate : options.sampleRates){
+            CoefficientTables tables;
+            tables.prepare(sampleRate);
+            
+            for (auto slope : options.slopes){
+                auto withSlope = [slope](ChainSettings settings){
+                    settings.lowCutSlope = settings.highCutSlope = static_cast<Slope>(slope);
+                    return settings;
+                };
+                
+                auto row = [&](const juce::String& name, double nsPerCall){
+                    out << name << ",," << sampleRate << "," << slope << ",,,ns_per_call," << nsPerCall << "\n";
+                };
+                
+                row("makeLowCutFilter", timeDesign([&](const ChainSettings& s){ return (double) makeLowCutFilter(withSlope(s), sampleRate)[0]->coefficients[0]; }, options.designCalls));
+                row("makeHighCutFilter", timeDesign([&](const ChainSettings& s){ return (double) makeHighCutFilter(withSlope(s), sampleRate)[0]->coefficients[0]; }, options.designCalls));
+                row("makeLowCutCoefficients", timeDesign([&](const ChainSettings& s){ return makeLowCutCoefficients(withSlope(s), sampleRate)[0][0]; }, options.designCalls));
+                row("makeHighCutCoefficients", timeDesign([&](const ChainSettings& s){ return makeHighCutCoefficients(withSlope(s), sampleRate)[0][0]; }, options.designCalls));
+                row("CoefficientTables::makeLowCutCoefficients", timeDesign([&](const ChainSettings& s){ return tables.makeLowCutCoefficients(withSlope(s))[0][0]; }, options.designCalls));
+                row("CoefficientTables::makeHighCutCoefficients", timeDesign([&](const ChainSettings& s){ return tables.makeHighCutCoefficients(withSlope(s))[0][0]; }, options.designCalls));
+            }
+            
+            auto row = [&](const juce::String& name, double nsPerCall){
+                out << name << ",," << sampleRate << ",,,,ns_per_call," << nsPerCall << "\n";
+            };
+            
+            row("makeBandFilter", timeDesign([&](const ChainSettings& s){ return (double) makeBandFilter(s.bands[0], s.designMethod, sampleRate)->coefficients[0]; }, options.designCalls));
+            row("makeBandCoefficients", timeDesign([&](const ChainSettings& s){ return makeBandCoefficients(s.bands[0], s.designMethod, sampleRate)[0]; }, options.designCalls));
+            row("CoefficientTables::makeBandCoefficients", timeDesign([&](const ChainSettings& s){ return tables.makeBandCoefficients(s.bands[0], s.designMethod)[0]; }, options.designCalls));
+            
+            // Matched bells are designed directly, so after the first sweep these come from the shared cache.
+            row("makeBandCoefficients (matched)", timeDesign([&](const ChainSettings& s){ return makeBandCoefficients(s.bands[0], DesignMethod_Matched, sampleRate)[0]; }, options.designCalls));
+            
+            auto before = cache->getBandStatistics();
+            row("CoefficientTables::makeBandCoefficients (matched)", timeDesign([&](const ChainSettings& s){ return tables.makeBandCoefficients(s.bands[0], DesignMethod_Matched)[0]; }, options.designCalls));
+            auto after = cache->getBandStatistics();
+            
+            out << "CoefficientCache::getBandCoefficients,," << sampleRate << ",,,,hit_rate,"
+                << static_cast<double>(after.hits - before.hits) / static_cast<double>(juce::jmax<juce::uint64>(1, after.lookups - before.lookups)) << "\n";
+            
+            // What each further instance pays to set its tables up, now that the grid for this rate exists.
+            row("CoefficientTables::prepare", timeDesign([&](const ChainSettings&){
+                CoefficientTables instanceTables;
+                instanceTables.prepare(sampleRate);
+                return instanceTables.getSampleRate();
+            }, options.designCalls));
+        }
+    }
+    
+    /** Mean ns for a fresh instance to load a state with every parameter moved, as a project full of them would. */
+    double timeStateLoading(const juce::MemoryBlock& state, int numInstances){
+        std::vector<std::unique_ptr<FirstEQAudioProcessor>> instances;
+        
+        for (int i = 0; i < numInstances; ++i)
+            instances.push_back(std::make_unique<FirstEQAudioProcessor>());
+        
+        auto start = juce::Time::getHighResolutionTicks();
+        
+        for (auto& instance : instances)
+            instance->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        
+        return ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start) / numInstances;
+    }
+    
+    void runStateBenchmarks(const BenchmarkOptions& options, juce::OutputStream& out){
+        FirstEQAudioProcessor processor;
+        juce::Random random(1);
+        
+        for (auto* param : processor.getParameters())
+            param->setValueNotifyingHost(random.nextFloat());
+        
+        juce::MemoryBlock snapshotState, valueTreeState;
+        processor.getStateInformation(snapshotState);
+        
+        // The format sessions were saved in before snapshots, which setStateInformation still reads.
+        {
+            juce::MemoryOutputStream stream(valueTreeState, false);
+            processor.apvts.copyState().writeToStream(stream);
+        }
+        
+        auto rows = [&](const juce::String& name, const juce::MemoryBlock& state){
+            out << name << ",,,,,,bytes," << static_cast<juce::int64>(state.getSize()) << "\n";
+            out << name << ",,,,,,ns_per_call," << timeStateLoading(state, options.stateInstances) << "\n";
+        };
+        
+        rows("setStateInformation (value tree)", valueTreeState);
+        rows("setStateInformation (snapshot)", snapshotState);
+    }
+    
+    void runProcessBenchmarks(const BenchmarkOptions& options, juce::OutputStream& out){
+        for (auto blockSize : options.blockSizes)
+            for (auto sampleRate : options.sampleRates)
+                for (auto slope : options.slopes)
+                    for (auto numChannels : options.channelCounts)
+                        for (auto automationRate : options.automationRates){
+                            auto nsPerSample = timeProcessBlock(blockSize, sampleRate, slope, numChannels, automationRate, options.repetitions, options.stereoMode);
+                            out << "processBlock," << blockSize << "," << sampleRate << "," << slope << "," << numChannels << ","
+                                << automationRate << ",ns_per_sample," << nsPerSample << "\n";
+                            out.flush();
+                        }
+    }
+    
+    void printUsage(){
+        std::cout << "Usage: FirstEQBenchmark [options]\n"
+                     "\n"
+                     "  --output <file>       write the CSV here instead of to stdout\n"
+                     "  --quick               a reduced grid, for a fast smoke run\n"
+                     "  --repetitions <n>     timed passes per processBlock point (default: 5)\n"
+                     "  --design-only         only time the filter-design functions\n"
+                     "  --process-only        only time processBlock\n"
+                     "  --state-only          only time loading states into fresh instances\n"
+                     "  --stereo-mode <mode>  linked, mid-side or dual-mono, for every processBlock point (default: linked)\n"
+                  << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor's parameters and value tree expect a message manager to exist.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    BenchmarkOptions options;
+    juce::File outputFile;
+    bool runDesign = true, runProcess = true, runState = true;
+    
+    for (int i = 1; i < argc; ++i){
+        juce::String arg(argv[i]);
+        auto hasValue = i + 1 < argc;
+        
+        if (arg == "--output" && hasValue)
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (arg == "--repetitions" && hasValue)
+            options.repetitions = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--quick"){
+            options.blockSizes = { 1, 64, 512, 8192 };
+            options.sampleRates = { 48000.0 };
+            options.slopes = { Slope_12, Slope_48 };
+            options.channelCounts = { 2 };
+            options.automationRates = { 0.0, 100.0 };
+            options.designCalls = 1000;
+            options.stateInstances = 50;
+        }
+        else if (arg == "--design-only")
+            runProcess = runState = false;
+        else if (arg == "--process-only")
+            runDesign = runState = false;
+        else if (arg == "--state-only")
+            runDesign = runProcess = false;
+        else if (arg == "--stereo-mode" && hasValue && stereoModeNames.contains(argv[i + 1]))
+            options.stereoMode = static_cast<StereoMode>(stereoModeNames.indexOf(argv[++i]));
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+    
+    std::unique_ptr<juce::OutputStream> out;
+    
+    if (outputFile != juce::File()){
+        outputFile.deleteFile();
+        out = outputFile.createOutputStream();
+        
+        if (out == nullptr){
+            std::cerr << "Can't write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else{
+        out = std::make_unique<juce::MemoryOutputStream>();
+    }
+    
+    *out << "benchmark,block_size,sample_rate,slope,channels,automation_hz,metric,value\n";
+    
+    if (runDesign)
+        runDesignBenchmarks(options, *out);
+    
+    if (runState)
+        runStateBenchmarks(options, *out);
+    
+    if (runProcess)
+        runProcessBenchmarks(options, *out);
+    
+    out->flush();
+    
+    if (auto* memory = dynamic_cast<juce::MemoryOutputStream*>(out.get()))
+        std::cout << memory->toString();
+    
+    return 0;
+}
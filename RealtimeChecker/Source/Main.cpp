@@ -0,0 +1,414 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    FirstEQRealtimeChecker: drives FirstEQAudioProcessor::processBlock from
+    its own audio thread, the way a host would, while the parameters are
+    automated at random, states are loaded and the editor is opened and closed
+    on the message thread. Every processBlock call, and every automation point
+    the audio thread delivers between blocks, runs inside a
+    RealtimeGuard::ScopedCheck, and the checker exits with an error if any of
+    them allocated, freed, locked, woke a thread, slept or made a blocking syscall.
+
+    Delivering automation goes through JUCE's parameter and value tree
+    listener lists, which lock, and with an editor open through its
+    attachments, which post to the message queue. Those calls are allowed
+    for the duration of setValueNotifyingHost() only. The processor's
+    parameter callbacks run inside it, so a stand-in host listener also
+    counts any notification the processor sends the host from the audio
+    thread, such as setLatencySamples().
+
+    Before the rounds, a few checks of what the processor publishes and runs
+    make sure the paths the rounds exercise actually do their job; the checker
+    also exits with an error if any of them fails.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "RealtimeGuard.h"
+
+namespace
+{
+    struct CheckerOptions
+    {
+        int rounds { 8 };
+        int secondsPerRound { 2 };
+        juce::int64 seed { 1 };
+        bool abortOnViolation { false };
+    };
+
+    /** One prepareToPlay's worth of host settings. */
+    struct Round
+    {
+        double sampleRate;
+        int maxBlockSize, numChannels;
+        bool doublePrecision;
+
+        juce::String getDescription() const{
+            return juce::String(sampleRate) + " Hz, " + juce::String(maxBlockSize) + " samples, "
+                 + juce::String(numChannels) + " channels, " + (doublePrecision ? "double" : "float");
+        }
+    };
+
+    juce::AudioProcessor::BusesLayout makeLayout(int numChannels){
+        auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+        if (channelSet.isDisabled())
+            channelSet = juce::AudioChannelSet::discreteChannels(numChannels);
+
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channelSet);
+        layout.outputBuses.add(channelSet);
+        return layout;
+    }
+
+    void setRandomValue(juce::AudioProcessorParameter& param, juce::Random& random){
+        param.setValueNotifyingHost(random.nextFloat());
+    }
+
+    /** An automation point, as a host delivers it on the audio thread. JUCE's own delivery locks its listener
+        lists and posts to any editor's attachments (an allocation, a lock and a write to the message queue's
+        pipe), so those are let through; waking a thread, waits, sleeps and reads still count, and so does
+        telling the host. So a processor that wakes one of its own threads from a parameter callback is
+        caught, even though the lock that takes is let through.
+    */
+    void automate(juce::AudioProcessorParameter& param, juce::Random& random){
+        auto value = random.nextFloat();
+
+        const RealtimeGuard::ScopedCheck check;
+        const RealtimeGuard::ScopedAllow allow { RealtimeGuard::Hook_pthread_mutex_lock, RealtimeGuard::Hook_write,
+                                                 RealtimeGuard::Hook_malloc, RealtimeGuard::Hook_realloc, RealtimeGuard::Hook_free,
+                                                 RealtimeGuard::Hook_operator_new, RealtimeGuard::Hook_operator_delete };
+        param.setValueNotifyingHost(value);
+    }
+
+    /** Stands in for the host. A processor that calls updateHostDisplay() or setLatencySamples() from the
+        audio thread reaches it there, and a real host would take its own locks to handle it.
+    */
+    struct HostListener : juce::AudioProcessorListener
+    {
+        void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
+
+        void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override{
+            RealtimeGuard::check(RealtimeGuard::Hook_host_notification);
+        }
+    };
+
+    /**
+        Calls processBlock back to back with random block lengths, on noise or on silence, with
+        random automation in between. Everything but processBlock and the automation is unchecked.
+    */
+    class AudioThread : public juce::Thread
+    {
+    public:
+        AudioThread(FirstEQAudioProcessor& p, const Round& r, juce::int64 seed)
+            : juce::Thread("FirstEQ Realtime Checker Audio"), processor(p), round(r), random(seed),
+              floatBuffer(r.numChannels, r.maxBlockSize), doubleBuffer(r.numChannels, r.maxBlockSize)
+        {
+            for (auto* param : processor.getParameters())
+                parameters.add(param);
+        }
+
+        void run() override{
+            while (! threadShouldExit()){
+                auto numSamples = random.nextInt({ 1, round.maxBlockSize + 1 });
+
+                // About one block in twenty carries an automation point, as a busy session would.
+                if (random.nextInt(20) == 0)
+                    automate(*parameters[random.nextInt(parameters.size())], random);
+
+                auto silent = random.nextInt(8) == 0;
+
+                if (round.doublePrecision)
+                    processBlock(doubleBuffer, numSamples, silent);
+                else
+                    processBlock(floatBuffer, numSamples, silent);
+
+                ++blocksProcessed;
+            }
+        }
+
+        int getBlocksProcessed() const noexcept { return blocksProcessed; }
+
+    private:
+        template <typename SampleType>
+        void processBlock(juce::AudioBuffer<SampleType>& buffer, int numSamples, bool silent){
+            for (int channel = 0; channel < round.numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample(channel, i, silent ? SampleType() : static_cast<SampleType>(random.nextFloat() * 2.f - 1.f));
+
+            // A view onto the start of the buffer: up to 32 channels, it doesn't allocate either.
+            juce::AudioBuffer<SampleType> block(buffer.getArrayOfWritePointers(), round.numChannels, 0, numSamples);
+
+            const RealtimeGuard::ScopedCheck check;
+            processor.processBlock(block, midi);
+        }
+
+        FirstEQAudioProcessor& processor;
+        Round round;
+        juce::Random random;
+
+        juce::Array<juce::AudioProcessorParameter*> parameters;
+        juce::AudioBuffer<float> floatBuffer;
+        juce::AudioBuffer<double> doubleBuffer;
+        juce::MidiBuffer midi;
+
+        std::atomic<int> blocksProcessed { 0 };
+    };
+
+    /** Runs one round: prepares, then plays the host's message thread while the audio thread runs. */
+    int runRound(FirstEQAudioProcessor& processor, const Round& round, const juce::Array<juce::MemoryBlock>& states,
+                 int secondsToRun, juce::Random& random){
+        processor.setBusesLayout(makeLayout(round.numChannels));
+        // As a host would, so getSampleRate() is set before the first block.
+        processor.setRateAndBufferSizeDetails(round.sampleRate, round.maxBlockSize);
+        processor.prepareToPlay(round.sampleRate, round.maxBlockSize);
+
+        std::unique_ptr<juce::AudioProcessorEditor> editor;
+        AudioThread audioThread(processor, round, random.nextInt64());
+        audioThread.startThread();
+
+        auto end = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(secondsToRun * 1000);
+
+        while (juce::Time::getMillisecondCounter() < end){
+            switch (random.nextInt(4)){
+                case 0:
+                    if (editor == nullptr)
+                        editor.reset(processor.createEditorIfNeeded());
+                    else
+                        editor.reset();
+                    break;
+                case 1:{
+                    const auto& state = states.getReference(random.nextInt(states.size()));
+                    processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                    break;
+                }
+                default:{
+                    auto& parameters = processor.getParameters();
+                    setRandomValue(*parameters[random.nextInt(parameters.size())], random);
+                    break;
+                }
+            }
+
+            juce::Thread::sleep(random.nextInt({ 1, 20 }));
+        }
+
+        audioThread.stopThread(1000);
+        editor.reset();
+        processor.releaseResources();
+
+        return audioThread.getBlocksProcessed();
+    }
+
+    /** A few complete states with every parameter set at random, for the rounds to load. */
+    juce::Array<juce::MemoryBlock> makeStates(FirstEQAudioProcessor& processor, juce::Random& random){
+        juce::Array<juce::MemoryBlock> states;
+
+        for (int i = 0; i < 4; ++i){
+            for (auto* param : processor.getParameters())
+                setRandomValue(*param, random);
+
+            juce::MemoryBlock state;
+            processor.getStateInformation(state);
+            states.add(state);
+        }
+
+        return states;
+    }
+
+    void setParameter(FirstEQAudioProcessor& processor, const juce::String& parameterID, float value){
+        if (auto* param = processor.apvts.getParameter(parameterID))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    /** The newest published set, once the designer thread has caught up with everything asked of it. */
+    const ChainCoefficients& waitForDesigns(FirstEQAudioProcessor& processor){
+        auto version = processor.getCoefficientSnapshot().version;
+
+        // A quiet spell several times the designer thread's poll interval means it has nothing left to do.
+        for (int quietPolls = 0; quietPolls < 5;){
+            juce::Thread::sleep(20);
+
+            auto latest = processor.getCoefficientSnapshot().version;
+            quietPolls = latest == version ? quietPolls + 1 : 0;
+            version = latest;
+        }
+
+        return processor.getCoefficientSnapshot().coefficients;
+    }
+
+    void prepare(FirstEQAudioProcessor& processor, double sampleRate, int maxBlockSize){
+        processor.setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+        processor.prepareToPlay(sampleRate, maxBlockSize);
+    }
+
+    /** Morphing halfway between two stored slots publishes bands strictly between the two slots' designs. */
+    bool checkMorph(){
+        FirstEQAudioProcessor processor;
+        prepare(processor, 48000.0, 512);
+
+        auto& bank = processor.getSnapshotBank();
+        setParameter(processor, "Peak Gain", -6.f);
+        bank.store(0);
+        setParameter(processor, "Peak Gain", 6.f);
+        bank.store(1);
+
+        bank.recall(1);
+        auto to = waitForDesigns(processor).parametric;
+        bank.recall(0);
+        auto from = waitForDesigns(processor).parametric;
+
+        setParameter(processor, "Morph Target", 1.f);
+        setParameter(processor, "Morph", 0.5f);
+        auto halfway = waitForDesigns(processor).parametric;
+
+        auto numDiffering = 0;
+
+        for (size_t channel = 0; channel < halfway.size(); ++channel){
+            for (size_t band = 0; band < halfway[channel].size(); ++band){
+                for (size_t i = 0; i < halfway[channel][band].size(); ++i){
+                    auto a = from[channel][band][i], b = to[channel][band][i], c = halfway[channel][band][i];
+
+                    if (a == b){
+                        if (c != a)
+                            return false;
+                    }
+                    else if (c <= juce::jmin(a, b) || c >= juce::jmax(a, b)){
+                        return false;
+                    }
+                    else{
+                        ++numDiffering;
+                    }
+                }
+            }
+        }
+
+        return numDiffering > 0;
+    }
+
+    /** An instance left at its defaults has nothing to filter, so processBuffer() bypasses the cascades. */
+    bool checkDefaultBypass(){
+        FirstEQAudioProcessor processor;
+        ChainParameters parameters(processor.apvts);
+        auto coefficients = makeChainCoefficients(getChainSettings(parameters), 48000.0);
+
+        OversampledCascade<SIMDFloat> cascade;
+        OversampledCascade<SIMDDouble> doubleCascade;
+        cascade.setCoefficients(coefficients);
+        doubleCascade.setCoefficients(coefficients);
+
+        return cascade.isIdentity() && doubleCascade.isIdentity();
+    }
+
+    /** Runs every check, printing each one's result. Returns false if any failed. */
+    bool runChecks(){
+        const std::vector<std::pair<const char*, std::function<bool()>>> checks {
+            { "Morphing halfway between two slots", checkMorph },
+            { "Bypassing a default instance", checkDefaultBypass }
+        };
+
+        auto passed = true;
+
+        for (const auto& [name, check] : checks){
+            auto result = check();
+            std::cout << name << ": " << (result ? "passed" : "FAILED") << std::endl;
+            passed = passed && result;
+        }
+
+        return passed;
+    }
+
+    void printUsage(){
+        std::cout << "Usage: FirstEQRealtimeChecker [options]\n"
+                     "\n"
+                     "  --rounds <n>              host configurations to run through (default: 8)\n"
+                     "  --seconds <n>             seconds per configuration (default: 2)\n"
+                     "  --seed <n>                seed for every random choice (default: 1)\n"
+                     "  --abort-on-violation      stop at the first violation, for a debugger or core dump\n"
+                  << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // Before anything else, so the hooks' own lookups never happen on a checked thread.
+    auto interposed = RealtimeGuard::install();
+
+    // The processor's parameters and value tree, and the editor, expect a message manager to exist.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    CheckerOptions options;
+
+    for (int i = 1; i < argc; ++i){
+        juce::String arg(argv[i]);
+        auto hasValue = i + 1 < argc;
+
+        if (arg == "--rounds" && hasValue)
+            options.rounds = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--seconds" && hasValue)
+            options.secondsPerRound = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--seed" && hasValue)
+            options.seed = juce::String(argv[++i]).getLargeIntValue();
+        else if (arg == "--abort-on-violation")
+            options.abortOnViolation = true;
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (! interposed)
+        std::cout << "Only operator new and delete can be checked on this platform." << std::endl;
+
+    RealtimeGuard::setAbortOnViolation(options.abortOnViolation);
+
+    auto checksPassed = runChecks();
+
+    juce::Random random(options.seed);
+    FirstEQAudioProcessor processor;
+    auto states = makeStates(processor, random);
+
+    HostListener hostListener;
+    processor.addListener(&hostListener);
+
+    const juce::Array<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+    const juce::Array<int> blockSizes { 16, 64, 128, 256, 512, 1024, 4096 };
+    const juce::Array<int> channelCounts { 1, 2, 6 };
+
+    juce::Array<Round> rounds;
+
+    for (int i = 0; i < options.rounds; ++i){
+        Round round { sampleRates[random.nextInt(sampleRates.size())], blockSizes[random.nextInt(blockSizes.size())],
+                      channelCounts[random.nextInt(channelCounts.size())], random.nextBool() };
+        rounds.add(round);
+
+        RealtimeGuard::setContext(i);
+        auto blocks = runRound(processor, round, states, options.secondsPerRound, random);
+
+        std::cout << "Round " << i + 1 << " (" << round.getDescription() << "): " << blocks << " blocks" << std::endl;
+    }
+
+    processor.removeListener(&hostListener);
+
+    if (RealtimeGuard::getTotalViolations() == 0){
+        std::cout << "No violations." << std::endl;
+        return checksPassed ? 0 : 1;
+    }
+
+    std::cout << "\nprocessBlock isn't real-time safe:\n";
+
+    for (int hook = 0; hook < RealtimeGuard::numHooks; ++hook)
+        if (auto count = RealtimeGuard::getViolations(static_cast<RealtimeGuard::Hook>(hook)))
+            std::cout << "  " << RealtimeGuard::getName(static_cast<RealtimeGuard::Hook>(hook)) << ": " << count << "\n";
+
+    auto first = RealtimeGuard::getFirstViolationContext();
+    std::cout << "The first was " << RealtimeGuard::getName(static_cast<RealtimeGuard::Hook>(RealtimeGuard::getFirstViolationHook()))
+              << ", in round " << first + 1 << " (" << rounds[first].getDescription()
+              << "). Run again with --abort-on-violation to see where it came from." << std::endl;
+
+    return 1;
+}
@@ -0,0 +1,465 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Only Linux lets an executable replace the C library's functions for every library it loads.
+// Elsewhere, only operator new and delete are checked.
+#if defined (__linux__)
+ #define FIRSTEQ_REALTIME_GUARD_INTERPOSES 1
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <sys/mman.h>
+ #include <time.h>
+ #include <unistd.h>
+
+ // The clock-selecting waits came with glibc 2.30. libstdc++ uses them for every timed wait on a
+ // steady clock, such as std::condition_variable::wait_for.
+ #if defined (__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+  #define FIRSTEQ_REALTIME_GUARD_HAS_CLOCKWAIT 1
+ #else
+  #define FIRSTEQ_REALTIME_GUARD_HAS_CLOCKWAIT 0
+ #endif
+#else
+ #define FIRSTEQ_REALTIME_GUARD_INTERPOSES 0
+#endif
+
+namespace RealtimeGuard
+{
+    static const char* const hookNames[numHooks] = {
+        "malloc", "calloc", "realloc", "free", "posix_memalign", "aligned_alloc",
+        "operator new", "operator delete",
+        "pthread_mutex_lock", "pthread_mutex_timedlock", "pthread_rwlock_rdlock", "pthread_rwlock_wrlock",
+        "pthread_cond_wait", "pthread_cond_timedwait", "pthread_cond_clockwait",
+        "pthread_cond_signal", "pthread_cond_broadcast", "pthread_join",
+        "sem_wait", "sem_timedwait", "sem_clockwait",
+        "read", "write", "nanosleep", "usleep", "mmap", "munmap",
+        "host notification (updateHostDisplay, setLatencySamples)"
+    };
+
+    static_assert(numHooks <= 64, "one bit per hook in an allow mask");
+
+    static std::atomic<bool> installed { false }, abortOnViolation { false };
+    static std::atomic<int> violations[numHooks] {};
+    static std::atomic<int> currentContext { 0 }, firstContext { -1 }, firstHook { -1 };
+
+    // The nesting depth of ScopedChecks on each thread, and the hooks ScopedAllows let through, one bit
+    // each. pthread keys rather than thread_local, which can allocate on a thread's first access, from
+    // inside the allocator hooks.
+   #if FIRSTEQ_REALTIME_GUARD_INTERPOSES
+    static pthread_key_t depthKey, allowedKey;
+
+    static int getDepth() noexcept{
+        return installed.load(std::memory_order_relaxed) ? static_cast<int>(reinterpret_cast<intptr_t>(pthread_getspecific(depthKey))) : 0;
+    }
+
+    static void setDepth(int depth) noexcept{
+        if (installed.load(std::memory_order_relaxed))
+            pthread_setspecific(depthKey, reinterpret_cast<void*>(static_cast<intptr_t>(depth)));
+    }
+
+    static uint64_t getAllowed() noexcept{
+        return installed.load(std::memory_order_relaxed) ? static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pthread_getspecific(allowedKey))) : 0;
+    }
+
+    static void setAllowed(uint64_t allowed) noexcept{
+        if (installed.load(std::memory_order_relaxed))
+            pthread_setspecific(allowedKey, reinterpret_cast<void*>(static_cast<uintptr_t>(allowed)));
+    }
+   #else
+    static thread_local int depth = 0;
+    static thread_local uint64_t allowedHooks = 0;
+
+    static int getDepth() noexcept { return depth; }
+    static void setDepth(int newDepth) noexcept { depth = newDepth; }
+    static uint64_t getAllowed() noexcept { return allowedHooks; }
+    static void setAllowed(uint64_t allowed) noexcept { allowedHooks = allowed; }
+   #endif
+
+    static void writeError(const char* text) noexcept;
+
+    // Called first thing in every hook. It only touches atomics and the thread's keys, so it can't recurse into a hook itself.
+    void check(Hook hook) noexcept{
+        if (getDepth() <= 0 || (getAllowed() & (uint64_t { 1 } << hook)) != 0)
+            return;
+
+        violations[hook].fetch_add(1, std::memory_order_relaxed);
+
+        int none = -1;
+        if (firstHook.compare_exchange_strong(none, hook))
+            firstContext.store(currentContext.load());
+
+        if (abortOnViolation.load(std::memory_order_relaxed)){
+            writeError("RealtimeGuard: ");
+            writeError(hookNames[hook]);
+            writeError(" called from a checked thread\n");
+            std::abort();
+        }
+    }
+
+    ScopedCheck::ScopedCheck() noexcept  { setDepth(getDepth() + 1); }
+    ScopedCheck::~ScopedCheck() noexcept { setDepth(getDepth() - 1); }
+
+    ScopedAllow::ScopedAllow(std::initializer_list<Hook> hooks) noexcept : previous(getAllowed()){
+        auto allowed = previous;
+
+        for (auto hook : hooks)
+            allowed |= uint64_t { 1 } << hook;
+
+        setAllowed(allowed);
+    }
+
+    ScopedAllow::~ScopedAllow() noexcept { setAllowed(previous); }
+
+    void setAbortOnViolation(bool shouldAbort) noexcept { abortOnViolation = shouldAbort; }
+    void setContext(int context) noexcept               { currentContext = context; }
+
+    const char* getName(Hook hook) noexcept { return hookNames[hook]; }
+    int getViolations(Hook hook) noexcept   { return violations[hook].load(); }
+
+    int getTotalViolations() noexcept{
+        int total = 0;
+
+        for (auto& count : violations)
+            total += count.load();
+
+        return total;
+    }
+
+    int getFirstViolationContext() noexcept { return firstHook.load() >= 0 ? firstContext.load() : -1; }
+    int getFirstViolationHook() noexcept    { return firstHook.load(); }
+
+    void resetViolations() noexcept{
+        for (auto& count : violations)
+            count = 0;
+
+        firstHook = -1;
+        firstContext = -1;
+    }
+}
+
+//==============================================================================
+// Replacing the global operator new and delete works on every platform. They check, then go
+// straight to the platform allocator, so an allocation through new is only counted once.
+#if FIRSTEQ_REALTIME_GUARD_INTERPOSES
+extern "C" void* __libc_malloc(size_t);
+extern "C" void __libc_free(void*);
+extern "C" void* __libc_memalign(size_t, size_t);
+
+static void* allocate(size_t size) noexcept                       { return __libc_malloc(size); }
+static void* allocateAligned(size_t size, size_t alignment) noexcept { return __libc_memalign(alignment, size); }
+static void deallocate(void* p) noexcept                          { __libc_free(p); }
+static void freeAligned(void* p) noexcept                          { __libc_free(p); }
+#elif defined (_WIN32)
+static void* allocate(size_t size) noexcept                       { return std::malloc(size); }
+static void* allocateAligned(size_t size, size_t alignment) noexcept { return _aligned_malloc(size, alignment); }
+static void deallocate(void* p) noexcept                          { std::free(p); }
+static void freeAligned(void* p) noexcept                          { _aligned_free(p); }
+#else
+static void* allocate(size_t size) noexcept                       { return std::malloc(size); }
+static void deallocate(void* p) noexcept                          { std::free(p); }
+static void freeAligned(void* p) noexcept                          { std::free(p); }
+
+static void* allocateAligned(size_t size, size_t alignment) noexcept{
+    void* p = nullptr;
+    return posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) == 0 ? p : nullptr;
+}
+#endif
+
+static void* checkedNew(size_t size){
+    RealtimeGuard::check(RealtimeGuard::Hook_operator_new);
+
+    if (auto* p = allocate(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+static void* checkedAlignedNew(size_t size, std::align_val_t alignment){
+    RealtimeGuard::check(RealtimeGuard::Hook_operator_new);
+
+    if (auto* p = allocateAligned(size == 0 ? 1 : size, static_cast<size_t>(alignment)))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+static void checkedDelete(void* p) noexcept{
+    if (p == nullptr)
+        return;
+
+    RealtimeGuard::check(RealtimeGuard::Hook_operator_delete);
+    deallocate(p);
+}
+
+static void checkedAlignedDelete(void* p) noexcept{
+    if (p == nullptr)
+        return;
+
+    RealtimeGuard::check(RealtimeGuard::Hook_operator_delete);
+    freeAligned(p);
+}
+
+void* operator new(size_t size)                                          { return checkedNew(size); }
+void* operator new[](size_t size)                                        { return checkedNew(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept          { try { return checkedNew(size); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept        { try { return checkedNew(size); } catch (...) { return nullptr; } }
+void* operator new(size_t size, std::align_val_t alignment)              { return checkedAlignedNew(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment)            { return checkedAlignedNew(size, alignment); }
+
+void operator delete(void* p) noexcept                                   { checkedDelete(p); }
+void operator delete[](void* p) noexcept                                 { checkedDelete(p); }
+void operator delete(void* p, size_t) noexcept                           { checkedDelete(p); }
+void operator delete[](void* p, size_t) noexcept                         { checkedDelete(p); }
+void operator delete(void* p, std::align_val_t) noexcept                 { checkedAlignedDelete(p); }
+void operator delete[](void* p, std::align_val_t) noexcept               { checkedAlignedDelete(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept         { checkedAlignedDelete(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept       { checkedAlignedDelete(p); }
+
+//==============================================================================
+#if FIRSTEQ_REALTIME_GUARD_INTERPOSES
+// The executable's definitions come first in symbol lookup, so defining the C functions
+// here replaces them for every library in the process. The allocator is reached through glibc's
+// __libc_ entry points; everything else is looked up in the next library along with dlsym.
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+
+template <typename Function>
+static Function next(std::atomic<void*>& cached, const char* name) noexcept{
+    auto* function = cached.load(std::memory_order_relaxed);
+
+    if (function == nullptr){
+        function = dlsym(RTLD_NEXT, name);
+        cached.store(function, std::memory_order_relaxed);
+    }
+
+    return reinterpret_cast<Function>(function);
+}
+
+#define FIRSTEQ_NEXT(name) \
+    static std::atomic<void*> cached { nullptr }; \
+    auto* const real = next<decltype(&::name)>(cached, #name)
+
+using namespace RealtimeGuard;
+
+extern "C"
+{
+    void* malloc(size_t size) noexcept                  { check(Hook_malloc); return __libc_malloc(size); }
+    void* calloc(size_t count, size_t size) noexcept    { check(Hook_calloc); return __libc_calloc(count, size); }
+    void* realloc(void* p, size_t size) noexcept        { check(Hook_realloc); return __libc_realloc(p, size); }
+    void free(void* p) noexcept                         { if (p != nullptr) check(Hook_free); __libc_free(p); }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept{
+        check(Hook_posix_memalign);
+
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return 22; // EINVAL
+
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : 12; // ENOMEM
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept { check(Hook_aligned_alloc); return __libc_memalign(alignment, size); }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept{
+        check(Hook_pthread_mutex_lock);
+        FIRSTEQ_NEXT(pthread_mutex_lock);
+        return real(mutex);
+    }
+
+    int pthread_mutex_timedlock(pthread_mutex_t* mutex, const struct timespec* time) noexcept{
+        check(Hook_pthread_mutex_timedlock);
+        FIRSTEQ_NEXT(pthread_mutex_timedlock);
+        return real(mutex, time);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept{
+        check(Hook_pthread_rwlock_rdlock);
+        FIRSTEQ_NEXT(pthread_rwlock_rdlock);
+        return real(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept{
+        check(Hook_pthread_rwlock_wrlock);
+        FIRSTEQ_NEXT(pthread_rwlock_wrlock);
+        return real(lock);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex){
+        check(Hook_pthread_cond_wait);
+        FIRSTEQ_NEXT(pthread_cond_wait);
+        return real(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time){
+        check(Hook_pthread_cond_timedwait);
+        FIRSTEQ_NEXT(pthread_cond_timedwait);
+        return real(condition, mutex, time);
+    }
+
+   #if FIRSTEQ_REALTIME_GUARD_HAS_CLOCKWAIT
+    int pthread_cond_clockwait(pthread_cond_t* condition, pthread_mutex_t* mutex, clockid_t clock, const struct timespec* time){
+        check(Hook_pthread_cond_clockwait);
+        FIRSTEQ_NEXT(pthread_cond_clockwait);
+        return real(condition, mutex, clock, time);
+    }
+   #endif
+
+    // Waking a thread isn't blocking in itself, but every wake-up JUCE offers locks the waiter's mutex
+    // first. Counting the wake-ups as well catches one even while the automation lets locks through.
+    int pthread_cond_signal(pthread_cond_t* condition){
+        check(Hook_pthread_cond_signal);
+        FIRSTEQ_NEXT(pthread_cond_signal);
+        return real(condition);
+    }
+
+    int pthread_cond_broadcast(pthread_cond_t* condition){
+        check(Hook_pthread_cond_broadcast);
+        FIRSTEQ_NEXT(pthread_cond_broadcast);
+        return real(condition);
+    }
+
+    int pthread_join(pthread_t thread, void** result){
+        check(Hook_pthread_join);
+        FIRSTEQ_NEXT(pthread_join);
+        return real(thread, result);
+    }
+
+    int sem_wait(sem_t* semaphore){
+        check(Hook_sem_wait);
+        FIRSTEQ_NEXT(sem_wait);
+        return real(semaphore);
+    }
+
+    int sem_timedwait(sem_t* semaphore, const struct timespec* time){
+        check(Hook_sem_timedwait);
+        FIRSTEQ_NEXT(sem_timedwait);
+        return real(semaphore, time);
+    }
+
+   #if FIRSTEQ_REALTIME_GUARD_HAS_CLOCKWAIT
+    int sem_clockwait(sem_t* semaphore, clockid_t clock, const struct timespec* time){
+        check(Hook_sem_clockwait);
+        FIRSTEQ_NEXT(sem_clockwait);
+        return real(semaphore, clock, time);
+    }
+   #endif
+
+    ssize_t read(int fd, void* buffer, size_t count){
+        check(Hook_read);
+        FIRSTEQ_NEXT(read);
+        return real(fd, buffer, count);
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t count){
+        check(Hook_write);
+        FIRSTEQ_NEXT(write);
+        return real(fd, buffer, count);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining){
+        check(Hook_nanosleep);
+        FIRSTEQ_NEXT(nanosleep);
+        return real(duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds){
+        check(Hook_usleep);
+        FIRSTEQ_NEXT(usleep);
+        return real(microseconds);
+    }
+
+    void* mmap(void* address, size_t length, int protection, int flags, int fd, off_t offset) noexcept{
+        check(Hook_mmap);
+        FIRSTEQ_NEXT(mmap);
+        return real(address, length, protection, flags, fd, offset);
+    }
+
+    int munmap(void* address, size_t length) noexcept{
+        check(Hook_munmap);
+        FIRSTEQ_NEXT(munmap);
+        return real(address, length);
+    }
+}
+
+void RealtimeGuard::writeError(const char* text) noexcept{
+    size_t length = 0;
+    while (text[length] != 0)
+        ++length;
+
+    static std::atomic<void*> cached { nullptr };
+    if (auto* real = next<decltype(&::write)>(cached, "write"))
+        real(2, text, length);
+}
+
+#else
+void RealtimeGuard::writeError(const char*) noexcept {}
+#endif
+
+//==============================================================================
+bool RealtimeGuard::install(){
+   #if FIRSTEQ_REALTIME_GUARD_INTERPOSES
+    if (! installed.load()){
+        if (pthread_key_create(&depthKey, nullptr) != 0 || pthread_key_create(&allowedKey, nullptr) != 0)
+            return false;
+
+        installed = true;
+
+        // Looks every forwarded function up now, on an unchecked thread, so dlsym's own
+        // allocations never land inside a check.
+        free(malloc(1));
+
+        // Timeouts already past, so none of these waits.
+        struct timespec past {};
+
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        pthread_mutex_lock(&mutex);
+        pthread_mutex_unlock(&mutex);
+        pthread_mutex_timedlock(&mutex, &past);
+        pthread_mutex_unlock(&mutex);
+
+        sem_t semaphore;
+        sem_init(&semaphore, 0, 2);
+        sem_timedwait(&semaphore, &past);
+
+       #if FIRSTEQ_REALTIME_GUARD_HAS_CLOCKWAIT
+        sem_clockwait(&semaphore, CLOCK_MONOTONIC, &past);
+
+        pthread_cond_t condition = PTHREAD_COND_INITIALIZER;
+        pthread_mutex_lock(&mutex);
+        pthread_cond_clockwait(&condition, &mutex, CLOCK_MONOTONIC, &past);
+        pthread_mutex_unlock(&mutex);
+        pthread_cond_destroy(&condition);
+       #endif
+
+        sem_destroy(&semaphore);
+
+        pthread_rwlock_t lock = PTHREAD_RWLOCK_INITIALIZER;
+        pthread_rwlock_rdlock(&lock);
+        pthread_rwlock_unlock(&lock);
+        pthread_rwlock_wrlock(&lock);
+        pthread_rwlock_unlock(&lock);
+
+        write(2, "", 0);
+        nanosleep(&past, nullptr);
+        usleep(0);
+        munmap(mmap(nullptr, 4096, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0), 4096);
+    }
+
+    return true;
+   #else
+    return false;
+   #endif
+}
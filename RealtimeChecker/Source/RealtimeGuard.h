@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 17 Oct 2026
+
+    Interposes the allocator, the blocking pthread calls and a few syscalls,
+    so that any of them made on a thread inside a ScopedCheck is counted as a
+    real-time-safety violation. Everything here is plain C++ and POSIX, with
+    no JUCE, so the hooks never depend on the code they are checking.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace RealtimeGuard
+{
+    enum Hook
+    {
+        Hook_malloc,
+        Hook_calloc,
+        Hook_realloc,
+        Hook_free,
+        Hook_posix_memalign,
+        Hook_aligned_alloc,
+        Hook_operator_new,
+        Hook_operator_delete,
+        Hook_pthread_mutex_lock,
+        Hook_pthread_mutex_timedlock,
+        Hook_pthread_rwlock_rdlock,
+        Hook_pthread_rwlock_wrlock,
+        Hook_pthread_cond_wait,
+        Hook_pthread_cond_timedwait,
+        Hook_pthread_cond_clockwait,
+        Hook_pthread_cond_signal,
+        Hook_pthread_cond_broadcast,
+        Hook_pthread_join,
+        Hook_sem_wait,
+        Hook_sem_timedwait,
+        Hook_sem_clockwait,
+        Hook_read,
+        Hook_write,
+        Hook_nanosleep,
+        Hook_usleep,
+        Hook_mmap,
+        Hook_munmap,
+        Hook_host_notification,     // not a C library call: counted by the checker's own stand-in host
+        numHooks
+    };
+
+    /** Call once at the start of main, before any thread is checked. Returns false where the C library
+        can't be interposed (anywhere but Linux), in which case only operator new and delete are checked.
+    */
+    bool install();
+
+    /** Checks the calling thread for as long as it exists. Checks nest. */
+    struct ScopedCheck
+    {
+        ScopedCheck() noexcept;
+        ~ScopedCheck() noexcept;
+
+        ScopedCheck(const ScopedCheck&) = delete;
+        ScopedCheck& operator=(const ScopedCheck&) = delete;
+    };
+
+    /** Inside a check, lets the given hooks through on the calling thread for as long as it exists, for a
+        call that is known to make them and isn't what's being checked. Every other hook still counts. Allows nest.
+    */
+    struct ScopedAllow
+    {
+        explicit ScopedAllow(std::initializer_list<Hook> hooks) noexcept;
+        ~ScopedAllow() noexcept;
+
+        ScopedAllow(const ScopedAllow&) = delete;
+        ScopedAllow& operator=(const ScopedAllow&) = delete;
+
+    private:
+        uint64_t previous;
+    };
+
+    /** Counts a violation of the given kind if the calling thread is inside a check and the hook isn't
+        allowed. Every hook calls this; so can a check of something that isn't a C library call.
+    */
+    void check(Hook hook) noexcept;
+
+    /** Stops the process at the first violation, so a debugger or core dump shows the call stack. */
+    void setAbortOnViolation(bool shouldAbort) noexcept;
+
+    /** Tags the violations that follow, so the first one can be traced back to what was running. */
+    void setContext(int context) noexcept;
+
+    const char* getName(Hook hook) noexcept;
+    int getViolations(Hook hook) noexcept;
+    int getTotalViolations() noexcept;
+
+    /** The context set when the first violation happened, or -1 if there hasn't been one. */
+    int getFirstViolationContext() noexcept;
+    int getFirstViolationHook() noexcept;
+
+    void resetViolations() noexcept;
+}
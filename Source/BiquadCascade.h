@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+
+// Channels are interleaved into the lanes of one SIMD register, so they all run
+// through each section together. Each lane has its own coefficients: even lanes take
+// the first channel of a stereo pair's, odd lanes the second's, so Mid/Side and dual
+// mono run the very same kernel as linked, with no extra sections.
+using SIMDFloat = juce::dsp::SIMDRegister<float>;
+using SIMDDouble = juce::dsp::SIMDRegister<double>;
+
+namespace CascadeHelpers
+{
+    template <typename SampleType>
+    struct Element
+    {
+        using Type = SampleType;
+        static SampleType expand(Type value) noexcept { return value; }
+        
+        // A lone channel is the first of its pair.
+        static SampleType fromPair(Type first, Type) noexcept { return first; }
+        static Type getMaxMagnitude(SampleType value) noexcept { return std::abs(value); }
+    };
+    
+    template <typename ElementType>
+    struct Element<juce::dsp::SIMDRegister<ElementType>>
+    {
+        using Type = ElementType;
+        static juce::dsp::SIMDRegister<ElementType> expand(Type value) noexcept { return juce::dsp::SIMDRegister<ElementType>::expand(value); }
+        
+        static juce::dsp::SIMDRegister<ElementType> fromPair(Type first, Type second) noexcept
+        {
+            auto result = expand(first);
+            
+            for (size_t i = 1; i < juce::dsp::SIMDRegister<ElementType>::size(); i += 2)
+                result.set(i, second);
+            
+            return result;
+        }
+        
+        static Type getMaxMagnitude(juce::dsp::SIMDRegister<ElementType> value) noexcept
+        {
+            Type result = 0;
+            
+            for (size_t i = 0; i < juce::dsp::SIMDRegister<ElementType>::size(); ++i)
+                result = juce::jmax(result, std::abs(value.get(i)));
+            
+            return result;
+        }
+    };
+}
+
+/**
+    The whole chain as fused transposed direct form II loops.
+
+    Only the active sections are stored, packed together in struct-of-arrays
+    form, and each sample goes through up to maxSectionsPerPass of them before
+    the next sample is read, so a block is swept through memory once per pass
+    rather than once per section, with no per-stage bypass checks.
+
+    The section count is a template parameter of the kernel, so its loop over
+    the sections is fully unrolled and the coefficients and state stay in
+    registers. Passes are capped so that still holds with every band in use.
+
+    Sections that pass their input straight through (see isIdentity) aren't
+    packed at all, so a neutral band costs nothing and a neutral chain runs no
+    kernel at all. Whenever the packing changes, the old sections keep running
+    alongside the new ones for fadeLength samples and are crossfaded out, so a
+    section leaving with state still ringing in it doesn't click.
+*/
+template <typename SampleType>
+class BiquadCascade
+{
+public:
+    /** Four low cut sections, the parametric bands, and four high cut sections. */
+    static constexpr int maxSections = 8 + maxParametricBands;
+    
+    /** The most sections one kernel runs per sweep over the block: enough for the original nine-section chain in one go. */
+    static constexpr int maxSectionsPerPass = 9;
+    
+    /** Samples over which the old packing is faded out. No longer than the smoother's control interval,
+        so a fade is over before the next coefficient step can change the packing again.
+    */
+    static constexpr int fadeLength = 32;
+    
+    /** Packs the active, non-identity sections of the given bands (see getBandMask). Sections that stay active keep their state. */
+    void setCoefficients(const ChainCoefficients& coefficients, int bands = allBands) noexcept;
+    
+    void reset() noexcept;
+    
+    void process(SampleType* samples, size_t numSamples) noexcept;
+    
+    int getNumSections() const noexcept { return sections.numSections; }
+    
+    /** The largest state in any packed section and any channel, or 1 while a fade is running. Once this
+        is tiny the cascade has finished ringing, and silence in will give silence out.
+    */
+    double getStateMagnitude() const noexcept;
+    
+    /** True when processing would leave the samples untouched: no sections packed and no fade running. */
+    bool isIdentity() const noexcept { return sections.numSections == 0 && fadeRemaining == 0; }
+    
+private:
+    using Helper = CascadeHelpers::Element<SampleType>;
+    using ElementType = typename Helper::Type;
+    
+    struct Sections;
+    using ProcessFunction = void (*)(Sections&, int, SampleType*, size_t);
+    
+    // One packing of the chain: its coefficients, its state and the kernel that runs it.
+    struct Sections
+    {
+        std::array<SampleType, maxSections> b0 {}, b1 {}, b2 {}, a1 {}, a2 {};
+        std::array<SampleType, maxSections> s1 {}, s2 {};
+        
+        // The position each packed section came from: low cut 0-3, then the parametric bands, then high cut.
+        std::array<int, maxSections> slots {};
+        int numSections { 0 };
+    };
+    
+    void addSection(int& index, int slot, const BiquadCoefficients& first, const BiquadCoefficients& second) noexcept;
+    void processFade(SampleType* samples, size_t numSamples) noexcept;
+    
+    static void processPacked(Sections& packed, SampleType* samples, size_t numSamples) noexcept;
+    static ProcessFunction getProcessFunction(int numSections) noexcept;
+    
+    template <int... Indices>
+    static void processSections(Sections& packed, int first, SampleType* samples, size_t numSamples, std::integer_sequence<int, Indices...>) noexcept;
+    
+    template <int NumSections>
+    static void processFixed(Sections& packed, int first, SampleType* samples, size_t numSamples) noexcept
+    {
+        processSections(packed, first, samples, numSamples, std::make_integer_sequence<int, NumSections>());
+    }
+    
+    static SampleType processSample(SampleType x, SampleType b0, SampleType b1, SampleType b2, SampleType a1, SampleType a2, SampleType& z1, SampleType& z2) noexcept
+    {
+        auto y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        return y;
+    }
+    
+    Sections sections, fadingOut;
+    int fadeRemaining { 0 };
+};
+
+//==============================================================================
+template <typename SampleType>
+void BiquadCascade<SampleType>::addSection(int& index, int slot, const BiquadCoefficients& first, const BiquadCoefficients& second) noexcept{
+    // A band on one channel of the pair only is still packed, as an identity section in the other's lanes.
+    if (::isIdentity(first) && ::isIdentity(second))
+        return;
+    
+    auto load = [&first, &second](size_t c){
+        return Helper::fromPair(static_cast<ElementType>(first[c]), static_cast<ElementType>(second[c]));
+    };
+    
+    sections.slots[index] = slot;
+    
+    sections.b0[index] = load(0);
+    sections.b1[index] = load(1);
+    sections.b2[index] = load(2);
+    sections.a1[index] = load(4);
+    sections.a2[index] = load(5);
+    
+    ++index;
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::setCoefficients(const ChainCoefficients& coefficients, int bands) noexcept{
+    // If the packing changes, this is what fades out: the old sections with their current state.
+    auto old = sections;
+    
+    int index = 0;
+    
+    if (bands & getBandMask(ChainPossitions::LowCut))
+        for (int i = 0; i <= coefficients.lowCutSlope; ++i)
+            addSection(index, i, coefficients.lowCut[i], coefficients.lowCut[i]);
+    
+    if (bands & getBandMask(ChainPossitions::Peak))
+        for (int i = 0; i < maxParametricBands; ++i)
+            addSection(index, 4 + i, coefficients.parametric[0][static_cast<size_t>(i)], coefficients.parametric[1][static_cast<size_t>(i)]);
+    
+    if (bands & getBandMask(ChainPossitions::HighCut))
+        for (int i = 0; i <= coefficients.highCutSlope; ++i)
+            addSection(index, 4 + maxParametricBands + i, coefficients.highCut[i], coefficients.highCut[i]);
+    
+    sections.numSections = index;
+    
+    if (sections.numSections == old.numSections && sections.slots == old.slots)
+        return;
+    
+    // The packing changed with a slope, the bands or a section turning identity, so move each
+    // surviving section's state to its new index. New sections start from silence.
+    for (int i = 0; i < sections.numSections; ++i){
+        sections.s1[i] = sections.s2[i] = Helper::expand(0);
+        
+        for (int j = 0; j < old.numSections; ++j){
+            if (old.slots[j] == sections.slots[i]){
+                sections.s1[i] = old.s1[j];
+                sections.s2[i] = old.s2[j];
+            }
+        }
+    }
+    
+    // A fade that's still running is cut short; the newest old packing is the one that fades out.
+    fadingOut = old;
+    fadeRemaining = fadeLength;
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::reset() noexcept{
+    for (int i = 0; i < maxSections; ++i)
+        sections.s1[i] = sections.s2[i] = Helper::expand(0);
+    
+    fadeRemaining = 0;
+}
+
+template <typename SampleType>
+double BiquadCascade<SampleType>::getStateMagnitude() const noexcept{
+    if (fadeRemaining > 0)
+        return 1.0;
+    
+    ElementType magnitude = 0;
+    
+    for (int i = 0; i < sections.numSections; ++i)
+        magnitude = juce::jmax(magnitude, Helper::getMaxMagnitude(sections.s1[i]), Helper::getMaxMagnitude(sections.s2[i]));
+    
+    return static_cast<double>(magnitude);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::process(SampleType* samples, size_t numSamples) noexcept{
+    if (fadeRemaining > 0)
+        processFade(samples, numSamples);
+    else
+        processPacked(sections, samples, numSamples);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::processFade(SampleType* samples, size_t numSamples) noexcept{
+    auto numFading = juce::jmin(numSamples, static_cast<size_t>(fadeRemaining));
+    
+    std::array<SampleType, fadeLength> old;
+    std::copy(samples, samples + numFading, old.begin());
+    
+    processPacked(fadingOut, old.data(), numFading);
+    processPacked(sections, samples, numSamples);
+    
+    for (size_t i = 0; i < numFading; ++i){
+        auto oldGain = Helper::expand(static_cast<ElementType>(fadeRemaining - static_cast<int>(i)) / static_cast<ElementType>(fadeLength));
+        samples[i] = samples[i] + (old[i] - samples[i]) * oldGain;
+    }
+    
+    fadeRemaining -= static_cast<int>(numFading);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::processPacked(Sections& packed, SampleType* samples, size_t numSamples) noexcept{
+    for (int first = 0; first < packed.numSections; first += maxSectionsPerPass)
+        getProcessFunction(juce::jmin(maxSectionsPerPass, packed.numSections - first))(packed, first, samples, numSamples);
+}
+
+template <typename SampleType>
+typename BiquadCascade<SampleType>::ProcessFunction BiquadCascade<SampleType>::getProcessFunction(int count) noexcept{
+    static constexpr std::array<ProcessFunction, maxSectionsPerPass + 1> kernels {
+        &processFixed<0>, &processFixed<1>, &processFixed<2>, &processFixed<3>, &processFixed<4>,
+        &processFixed<5>, &processFixed<6>, &processFixed<7>, &processFixed<8>, &processFixed<9>
+    };
+    
+    static_assert(maxSectionsPerPass == 9, "kernels needs an entry for every section count");
+    
+    return kernels[static_cast<size_t>(count)];
+}
+
+template <typename SampleType>
+template <int... Indices>
+void BiquadCascade<SampleType>::processSections(Sections& packed, int first, SampleType* samples, size_t numSamples, std::integer_sequence<int, Indices...>) noexcept{
+    if constexpr (sizeof...(Indices) > 0){
+        constexpr auto n = sizeof...(Indices);
+        
+        // Every index into the locals below is a compile-time constant, so they can all live in registers.
+        const std::array<SampleType, n> b0 { packed.b0[first + Indices]... }, b1 { packed.b1[first + Indices]... }, b2 { packed.b2[first + Indices]... };
+        const std::array<SampleType, n> a1 { packed.a1[first + Indices]... }, a2 { packed.a2[first + Indices]... };
+        std::array<SampleType, n> z1 { packed.s1[first + Indices]... }, z2 { packed.s2[first + Indices]... };
+        
+        for (size_t i = 0; i < numSamples; ++i){
+            auto x = samples[i];
+            ((x = processSample(x, b0[Indices], b1[Indices], b2[Indices], a1[Indices], a2[Indices], z1[Indices], z2[Indices])), ...);
+            samples[i] = x;
+        }
+        
+        ((packed.s1[first + Indices] = z1[Indices], packed.s2[first + Indices] = z2[Indices]), ...);
+    }
+    else{
+        juce::ignoreUnused(packed, first, samples, numSamples);
+    }
+}
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "CoefficientCache.h"
+
+CoefficientCache::FrequencyGrid::FrequencyGrid(double rate) :
+    sampleRate(rate),
+    pointsPerLog((numFrequencies - 1) / std::log(maxFrequency / minFrequency))
+{
+    sinW.resize(numFrequencies);
+    cosW.resize(numFrequencies);
+
+    for (int i = 0; i < numFrequencies; ++i){
+        auto frequency = minFrequency * std::exp(i / pointsPerLog);
+        auto w = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+        sinW[static_cast<size_t>(i)] = std::sin(w);
+        cosW[static_cast<size_t>(i)] = std::cos(w);
+
+        if (frequency < 0.5 * sampleRate)
+            numUsableFrequencies = i + 1;
+    }
+}
+
+CoefficientCache::FrequencyGrid::~FrequencyGrid(){
+    for (auto& table : matchedHighPass) delete table.load();
+    for (auto& table : matchedLowPass) delete table.load();
+}
+
+const BiquadCoefficients* CoefficientCache::FrequencyGrid::getMatchedCutTable(bool highPass, Slope slope) const{
+    auto& slot = (highPass ? matchedHighPass : matchedLowPass)[static_cast<size_t>(slope)];
+
+    if (const auto* table = slot.load(std::memory_order_acquire))
+        return table->data();
+
+    auto table = std::make_unique<MatchedTable>(static_cast<size_t>((slope + 1) * numFrequencies));
+
+    const auto& qualities = getButterworthQualities(slope);
+    BandSettings band;
+    band.type = highPass ? BandType_LowCut : BandType_HighCut;
+
+    for (int section = 0; section <= slope; ++section){
+        band.quality = static_cast<float>(qualities[static_cast<size_t>(section)]);
+
+        for (int i = 0; i < numUsableFrequencies; ++i){
+            band.frequency = static_cast<float>(minFrequency * std::exp(i / pointsPerLog));
+            (*table)[static_cast<size_t>(section * numFrequencies + i)] = makeBandCoefficients(band, DesignMethod_Matched, sampleRate);
+        }
+    }
+
+    const MatchedTable* expected = nullptr;
+
+    // If another instance got there first, its table is the same as this one, which is dropped.
+    if (slot.compare_exchange_strong(expected, table.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        return table.release()->data();
+
+    return expected->data();
+}
+
+//==============================================================================
+CoefficientCache::~CoefficientCache(){
+    for (const auto* grid = grids.load(); grid != nullptr;){
+        const auto* next = grid->next;
+        delete grid;
+        grid = next;
+    }
+}
+
+const CoefficientCache::FrequencyGrid& CoefficientCache::getFrequencyGrid(double sampleRate){
+    std::unique_ptr<FrequencyGrid> created;
+    auto* head = grids.load(std::memory_order_acquire);
+
+    for (;;){
+        for (const auto* grid = head; grid != nullptr; grid = grid->next)
+            if (grid->sampleRate == sampleRate)
+                return *grid;
+
+        if (created == nullptr)
+            created = std::make_unique<FrequencyGrid>(sampleRate);
+
+        created->next = head;
+
+        // On failure head is the newer list, which may now hold this rate, so it's searched again.
+        if (grids.compare_exchange_weak(head, created.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+            return *created.release();
+    }
+}
+
+BiquadCoefficients CoefficientCache::getBandCoefficients(const BandSettings& band, DesignMethod designMethod, double sampleRate){
+    auto key = makeBandKey(band, designMethod, sampleRate);
+    auto* set = &bandEntries[(key.getHash() % (maxBandEntries / numBandWays)) * numBandWays];
+
+    BiquadCoefficients coefficients;
+    bandLookups.fetch_add(1, std::memory_order_relaxed);
+
+    for (int way = 0; way < numBandWays; ++way){
+        if (set[way].find(key, coefficients)){
+            bandHits.fetch_add(1, std::memory_order_relaxed);
+            return coefficients;
+        }
+    }
+
+    coefficients = makeBandCoefficients(key.getBand(), designMethod, sampleRate);
+
+    // An entry that's never been written if the set has one, otherwise whichever way is next in turn.
+    auto victim = static_cast<int>(nextVictim.fetch_add(1, std::memory_order_relaxed) % numBandWays);
+
+    for (int way = 0; way < numBandWays; ++way){
+        if (set[way].sequence.load(std::memory_order_relaxed) == 0){
+            victim = way;
+            break;
+        }
+    }
+
+    set[victim].replace(key, coefficients);
+    return coefficients;
+}
+
+CoefficientCache::BandStatistics CoefficientCache::getBandStatistics() const noexcept{
+    return { bandLookups.load(std::memory_order_relaxed), bandHits.load(std::memory_order_relaxed) };
+}
+
+bool CoefficientCache::BandEntry::find(const BandKey& key, BiquadCoefficients& result) const noexcept{
+    auto before = sequence.load(std::memory_order_acquire);
+
+    if (before == 0 || (before & 1) != 0)
+        return false;
+
+    BandKey stored { sampleRate.load(std::memory_order_relaxed),
+                     type.load(std::memory_order_relaxed), designMethod.load(std::memory_order_relaxed),
+                     frequency.load(std::memory_order_relaxed), gain.load(std::memory_order_relaxed),
+                     quality.load(std::memory_order_relaxed) };
+
+    for (size_t i = 0; i < result.size(); ++i)
+        result[i] = coefficients[i].load(std::memory_order_relaxed);
+
+    // Keeps the loads above before the check that no write overlapped them.
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return sequence.load(std::memory_order_relaxed) == before && stored == key;
+}
+
+void CoefficientCache::BandEntry::replace(const BandKey& key, const BiquadCoefficients& newCoefficients) noexcept{
+    auto before = sequence.load(std::memory_order_relaxed);
+
+    if ((before & 1) != 0 || ! sequence.compare_exchange_strong(before, before + 1, std::memory_order_relaxed))
+        return;
+
+    // Keeps the odd count ahead of the stores below, so no reader takes a half-written entry as whole.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    sampleRate.store(key.sampleRate, std::memory_order_relaxed);
+    type.store(key.type, std::memory_order_relaxed);
+    designMethod.store(key.designMethod, std::memory_order_relaxed);
+    frequency.store(key.frequency, std::memory_order_relaxed);
+    gain.store(key.gain, std::memory_order_relaxed);
+    quality.store(key.quality, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < newCoefficients.size(); ++i)
+        coefficients[i].store(newCoefficients[i], std::memory_order_relaxed);
+
+    sequence.store(before + 2, std::memory_order_release);
+}
+
+CoefficientCache::BandKey CoefficientCache::makeBandKey(const BandSettings& band, DesignMethod designMethod, double sampleRate) noexcept{
+    // Notches and cuts have no gain, so any gain shares one entry.
+    auto hasGain = band.type == BandType_Bell || band.type == BandType_LowShelf || band.type == BandType_HighShelf;
+
+    return { sampleRate, band.type, designMethod,
+             juce::roundToInt(band.frequency * 100.f),
+             hasGain ? juce::roundToInt(band.gainInDecibels * 100.f) : 0,
+             juce::roundToInt(band.quality * 1000.f) };
+}
+
+bool CoefficientCache::BandKey::operator== (const BandKey& other) const noexcept{
+    return sampleRate == other.sampleRate && type == other.type && designMethod == other.designMethod
+        && frequency == other.frequency && gain == other.gain && quality == other.quality;
+}
+
+size_t CoefficientCache::BandKey::getHash() const noexcept{
+    auto hash = static_cast<juce::uint64>(std::hash<double>()(sampleRate));
+
+    for (auto value : { type, designMethod, frequency, gain, quality })
+        hash = hash * 31 + static_cast<juce::uint64>(value);
+
+    // MurmurHash3's finaliser, so a sweep's evenly spaced frequencies spread evenly over the sets.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+
+    return static_cast<size_t>(hash);
+}
+
+BandSettings CoefficientCache::BandKey::getBand() const noexcept{
+    BandSettings band;
+    band.type = static_cast<BandType>(type);
+    band.frequency = frequency / 100.f;
+    band.gainInDecibels = gain / 100.f;
+    band.quality = quality / 1000.f;
+
+    return band;
+}
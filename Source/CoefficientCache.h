@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+
+/**
+    Designs shared by every plugin instance in the process, so a session full of
+    FirstEQs with the same rate and settings lays each one out only once.
+
+    Finding an entry is a handful of atomic loads with no locks, so any thread but
+    the audio thread may use it (building a missing grid allocates). It holds two
+    kinds of entry:
+    - a FrequencyGrid for each sample rate, the tables CoefficientTables designs
+      from, by far the largest thing each instance would otherwise keep. These are
+      interned: whichever instance first needs one builds it and publishes it with
+      a single compare-and-swap, after which it is never changed or freed while
+      any instance is alive;
+    - the sections CoefficientTables designs directly, keyed by sample rate, band
+      type, design method and the band's settings rounded to a fine grid. These
+      are kept in a fixed table of sets, and a band missing from a full set
+      replaces one of the set's entries, so sweeping a band keeps the most recent
+      designs rather than the first few thousand. Entries are overwritten in
+      place under a sequence lock, so nothing is ever freed while it's read.
+*/
+class CoefficientCache
+{
+public:
+    /**
+        sin(w) and cos(w) over a log-frequency grid for one sample rate, and the
+        matched cut sections over the same grid, each Slope's designed the first
+        time any instance uses it. See CoefficientTables for how they are used.
+    */
+    class FrequencyGrid
+    {
+    public:
+        /** The grid spans the band and cut frequency ranges, about 400 points per octave. */
+        static constexpr int numFrequencies = 4096;
+        static constexpr double minFrequency = 20.0, maxFrequency = 20000.0;
+
+        explicit FrequencyGrid(double sampleRate);
+        ~FrequencyGrid();
+
+        const double sampleRate;
+        const double pointsPerLog;
+
+        // The points below Nyquist; the ones above it are never read.
+        int numUsableFrequencies { 0 };
+        std::vector<double> sinW, cosW;
+
+        /** Each section of the Slope at every grid point, section by section. */
+        const BiquadCoefficients* getMatchedCutTable(bool highPass, Slope slope) const;
+
+    private:
+        friend class CoefficientCache;
+
+        using MatchedTable = std::vector<BiquadCoefficients>;
+
+        mutable std::array<std::atomic<const MatchedTable*>, 4> matchedHighPass {}, matchedLowPass {};
+
+        // The grid for the rate interned before this one.
+        const FrequencyGrid* next { nullptr };
+
+        JUCE_DECLARE_NON_COPYABLE (FrequencyGrid)
+    };
+
+    CoefficientCache() = default;
+    ~CoefficientCache();
+
+    /** The grid for a rate, laid out if no instance has used that rate yet. */
+    const FrequencyGrid& getFrequencyGrid(double sampleRate);
+
+    /** makeBandCoefficients() from FilterChain.h, designed once per process for each distinct band. The band
+        is rounded to the cache's grid first, which is finer than any parameter's step.
+    */
+    BiquadCoefficients getBandCoefficients(const BandSettings& band, DesignMethod designMethod, double sampleRate);
+
+    /** How many getBandCoefficients() calls there have been, and how many found their band already designed. */
+    struct BandStatistics
+    {
+        juce::uint64 lookups, hits;
+    };
+
+    BandStatistics getBandStatistics() const noexcept;
+
+    /** The band entries, in sets of numBandWays. A band can only go in the set its key hashes to. */
+    static constexpr int maxBandEntries = 4096, numBandWays = 8;
+
+private:
+    struct BandKey
+    {
+        double sampleRate;
+        int type, designMethod;
+
+        // In hundredths of a Hz and of a dB, and thousandths of Q.
+        int frequency, gain, quality;
+
+        bool operator== (const BandKey& other) const noexcept;
+        size_t getHash() const noexcept;
+
+        BandSettings getBand() const noexcept;
+    };
+
+    static BandKey makeBandKey(const BandSettings& band, DesignMethod designMethod, double sampleRate) noexcept;
+
+    // One band's key and design, held in place. sequence is odd while they're being written and moves on by
+    // two each time they're replaced, so a reader that sees the same even count before and after copying them
+    // has a consistent copy. Zero means the entry has never been written.
+    struct BandEntry
+    {
+        std::atomic<juce::uint32> sequence;
+        std::atomic<double> sampleRate;
+        std::atomic<int> type, designMethod, frequency, gain, quality;
+        std::array<std::atomic<double>, 6> coefficients;
+
+        // False if the entry holds another band, or is being written.
+        bool find(const BandKey& key, BiquadCoefficients& result) const noexcept;
+
+        // Gives up if another thread is already writing the entry: that band is kept instead.
+        void replace(const BandKey& key, const BiquadCoefficients& newCoefficients) noexcept;
+    };
+
+    std::atomic<const FrequencyGrid*> grids { nullptr };
+    std::array<BandEntry, maxBandEntries> bandEntries {};
+
+    // Picks which way of a full set is replaced, in turn across all the sets.
+    std::atomic<juce::uint32> nextVictim { 0 };
+
+    std::atomic<juce::uint64> bandLookups { 0 }, bandHits { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientCache)
+};
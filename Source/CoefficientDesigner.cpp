@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "CoefficientDesigner.h"
+
+CoefficientDesignerThread::CoefficientDesignerThread() : juce::Thread("FirstEQ Coefficient Designer"){
+    startThread();
+}
+
+CoefficientDesignerThread::~CoefficientDesignerThread(){
+    stopThread(1000);
+}
+
+void CoefficientDesignerThread::addDesigner(CoefficientDesigner* designer){
+    const juce::ScopedLock sl(lock);
+    designers.add(designer);
+}
+
+void CoefficientDesignerThread::removeDesigner(CoefficientDesigner* designer){
+    for (;;){
+        {
+            const juce::ScopedLock sl(lock);
+            designers.removeFirstMatchingValue(designer);
+            
+            if (designing != designer)
+                break;
+        }
+        
+        designFinished.wait(10);
+    }
+    
+    // The designers after it moved down one, so a pass under way may skip one; the next poll gets to it.
+}
+
+void CoefficientDesignerThread::run(){
+    while (! threadShouldExit()){
+        for (int i = 0;; ++i){
+            CoefficientDesigner* designer;
+            
+            {
+                const juce::ScopedLock sl(lock);
+                designer = designing = designers[i];
+            }
+            
+            if (designer == nullptr)
+                break;
+            
+            designer->designDirtyBands();
+            
+            {
+                const juce::ScopedLock sl(lock);
+                designing = nullptr;
+            }
+            
+            designFinished.signal();
+        }
+        
+        wait(pollIntervalMs);
+    }
+}
+
+//==============================================================================
+CoefficientDesigner::CoefficientDesigner(const ChainParameters& p) : parameters(p){
+    designerThread->addDesigner(this);
+}
+
+CoefficientDesigner::~CoefficientDesigner(){
+    designerThread->removeDesigner(this);
+}
+
+void CoefficientDesigner::prepare(double newSampleRate, int numChannels){
+    {
+        const juce::ScopedLock sl(designLock);
+        
+        sampleRate = newSampleRate;
+        isStereo = numChannels == 2;
+        dirtyBands = 0;
+        
+        hostRateTables.prepare(sampleRate);
+        designed = {};
+        updateChainCoefficients(designed, getSettings(parameters), hostRateTables, oversampledTables, allBands);
+        
+        // Every target was designed for the old rate, or the old layout.
+        dirtyMorphTargets = (1 << numMorphTargets) - 1;
+        designMorphTargets();
+        
+        publish();
+    }
+    
+    notifyListener();
+}
+
+void CoefficientDesigner::designDirtyBands(){
+    // Most polls find nothing to do, and don't need the lock to see it.
+    if (dirtyBands.load() == 0 && ! morphDirty.load())
+        return;
+    
+    {
+        const juce::ScopedLock sl(designLock);
+        
+        if (sampleRate <= 0)
+            return;
+        
+        auto bands = dirtyBands.exchange(0);
+        auto morphChanged = morphDirty.exchange(false);
+        
+        if (bands == 0 && ! morphChanged)
+            return;
+        
+        // Only the redesigns are timed; republishing a morph is just an interpolation.
+        std::optional<PerformanceMonitor::ScopedTimer> timer;
+        
+        if (designTiming != nullptr && bands != 0)
+            timer.emplace(*designTiming, designBudgetSeconds);
+        
+        if (bands != 0)
+            updateChainCoefficients(designed, getSettings(parameters), hostRateTables, oversampledTables, bands);
+        
+        // setMorphTarget() marks the morph dirty, so any target it changed is designed here.
+        if (morphChanged)
+            designMorphTargets();
+        
+        publish();
+    }
+    
+    notifyListener();
+}
+
+void CoefficientDesigner::setMorphTarget(int index, const std::optional<ChainSettings>& settings){
+    {
+        const juce::ScopedLock sl(designLock);
+        
+        morphTargetSettings[static_cast<size_t>(index)] = settings;
+        dirtyMorphTargets |= 1 << index;
+    }
+    
+    markMorphDirty();
+}
+
+void CoefficientDesigner::recallMorphTarget(int index){
+    {
+        const juce::ScopedLock sl(designLock);
+        
+        const auto& target = morphTargets[static_cast<size_t>(index)];
+        
+        if (sampleRate <= 0 || ! target.has_value() || (dirtyMorphTargets & (1 << index)) != 0)
+            return;
+        
+        dirtyBands = 0;
+        designed = *target;
+        publish();
+    }
+    
+    notifyListener();
+}
+
+void CoefficientDesigner::designMorphTargets(){
+    if (sampleRate <= 0)
+        return;
+    
+    for (size_t i = 0; i < morphTargets.size(); ++i){
+        if ((dirtyMorphTargets & (1 << i)) == 0)
+            continue;
+        
+        auto& target = morphTargets[i];
+        const auto& settings = morphTargetSettings[i];
+        
+        if (settings.has_value()){
+            // The oversampled tables are prepared for each design anyway, so the live set's serve here too.
+            target.emplace();
+            updateChainCoefficients(*target, matchLayout(*settings), hostRateTables, oversampledTables, allBands);
+        }
+        else{
+            target.reset();
+        }
+    }
+    
+    dirtyMorphTargets = 0;
+}
+
+const ChainCoefficients& CoefficientDesigner::getMorphed(){
+    if (morphAmount == nullptr || morphTarget == nullptr)
+        return designed;
+    
+    auto amount = static_cast<double>(morphAmount->load());
+    const auto& target = morphTargets[static_cast<size_t>(juce::jlimit(0, numMorphTargets - 1, static_cast<int>(morphTarget->load())))];
+    
+    if (amount <= 0.0 || ! target.has_value())
+        return designed;
+    
+    morphed = interpolateChainCoefficients(designed, *target, amount);
+    return morphed;
+}
+
+ChainSettings CoefficientDesigner::getSettings(const ChainParameters& source) const{
+    return matchLayout(getChainSettings(source));
+}
+
+ChainSettings CoefficientDesigner::matchLayout(ChainSettings settings) const noexcept{
+    if (! isStereo)
+        settings.stereoMode = StereoMode_Linked;
+    
+    return settings;
+}
+
+void CoefficientDesigner::publish(){
+    const auto& output = getMorphed();
+    
+    coefficients.getWriteBuffer() = output;
+    coefficients.publish();
+    
+    auto& snapshot = snapshots.getWriteBuffer();
+    snapshot.coefficients = output;
+    snapshot.sampleRate = sampleRate;
+    snapshot.version = ++version;
+    snapshots.publish();
+    
+    tailLengthSeconds.store(getTailLengthSamples(output) / sampleRate, std::memory_order_relaxed);
+    
+    if (listener != nullptr)
+        listenerSnapshot = snapshot;
+}
+
+void CoefficientDesigner::notifyListener(){
+    if (listener == nullptr)
+        return;
+    
+    CoefficientSnapshot snapshot;
+    
+    {
+        const juce::ScopedLock sl(designLock);
+        snapshot = listenerSnapshot;
+    }
+    
+    listener->coefficientsDesigned(snapshot);
+}
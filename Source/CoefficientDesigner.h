@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+#include "CoefficientTables.h"
+#include "TripleBuffer.h"
+#include "PerformanceMonitor.h"
+
+class CoefficientDesigner;
+
+/** One published coefficient set, as handed to the editor. Never modified once published. */
+struct CoefficientSnapshot
+{
+    ChainCoefficients coefficients;
+    double sampleRate { 0 };
+    
+    // Goes up by one with every published set; 0 means nothing has been designed yet.
+    juce::uint32 version { 0 };
+};
+
+/**
+    One background thread, shared by every plugin instance in the process, that
+    redesigns the coefficients of any registered CoefficientDesigner whose
+    parameters have changed. Designers are marked dirty from the audio thread,
+    which mustn't take the lock waking a thread needs, so it polls them.
+
+    Each designer is redesigned under its own lock, not this thread's, so one
+    instance's redesign never holds up another's prepare().
+*/
+class CoefficientDesignerThread : public juce::Thread
+{
+public:
+    CoefficientDesignerThread();
+    ~CoefficientDesignerThread() override;
+    
+    void addDesigner(CoefficientDesigner* designer);
+    
+    /** Waits for a redesign of this designer that is already under way, if any. */
+    void removeDesigner(CoefficientDesigner* designer);
+    
+    void run() override;
+    
+private:
+    // A couple of blocks at typical sizes, so automation reaches the audio thread soon after it moves.
+    // A pass over designers with nothing dirty is only a couple of atomic loads each.
+    static constexpr int pollIntervalMs = 5;
+    
+    // Guards the list and which designer is being worked on, never the work itself.
+    juce::CriticalSection lock;
+    juce::Array<CoefficientDesigner*> designers;
+    CoefficientDesigner* designing { nullptr };
+    juce::WaitableEvent designFinished;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientDesignerThread)
+};
+
+/**
+    Designs the coefficients for one chain away from the audio thread and
+    publishes each complete set through a wait-free triple buffer. Designs come
+    from CoefficientTables, so automation moving many bands stays cheap.
+
+    The published set can be morphed part of the way towards one of a few sets
+    designed in advance (a snapshot bank's), which only takes an interpolation:
+    moving the morph never redesigns anything. The targets are handed over as
+    settings and designed on the designer thread too, only when they change.
+*/
+class CoefficientDesigner
+{
+public:
+    /** How many sets can be morphed towards, one per snapshot bank slot. */
+    static constexpr int numMorphTargets = 4;
+    
+    explicit CoefficientDesigner(const ChainParameters& parameters);
+    ~CoefficientDesigner();
+    
+    /** Gets each new set as it is published, on the thread that published it, with no lock held. Sets
+        published from two threads at once can arrive out of order, so compare their versions.
+    */
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void coefficientsDesigned(const CoefficientSnapshot& snapshot) = 0;
+    };
+    
+    /** Message thread, before prepare(): the listener must outlive this designer. */
+    void setListener(Listener* newListener) noexcept { listener = newListener; }
+    
+    /** Message thread, before prepare(): each redesign on the designer thread is timed into this. */
+    void setDesignTiming(TimingHistogram* histogram) noexcept { designTiming = histogram; }
+    
+    /** Message thread, before prepare(): the raw values of the morph amount (0 to 1) and the target's index. */
+    void setMorphParameters(std::atomic<float>* amount, std::atomic<float>* target) noexcept
+    {
+        morphAmount = amount;
+        morphTarget = target;
+    }
+    
+    /** Message thread: designs a full set, and every morph target, for the new sample rate and publishes it
+        straight away. The stereo modes need a pair of channels to work on, so with any other number every band is linked.
+    */
+    void prepare(double sampleRate, int numChannels);
+    
+    /** Any thread, wait-free: flags bands (see getBandMask) for the designer thread to redesign on its next poll. */
+    void markDirty(int bands) noexcept { dirtyBands.fetch_or(bands); }
+    
+    /** Any thread, wait-free: the morph moved, so the designer thread publishes again, without redesigning. */
+    void markMorphDirty() noexcept { morphDirty = true; }
+    
+    /** The budget each redesign is timed against: at control rate, automation never waits longer than this. */
+    static constexpr double designBudgetSeconds = 0.001;
+    
+    /** Message thread: settings, such as a stored snapshot's, the published set can be morphed towards, or
+        nothing to clear that target. The designer thread designs them; nothing is designed here.
+    */
+    void setMorphTarget(int index, const std::optional<ChainSettings>& settings);
+    
+    /** Message thread: for parameters that have just been set to a morph target's settings, publishes that
+        target's set in place of a redesign, and clears the bands they flagged as dirty. If the target hasn't
+        been designed yet, the redesign goes ahead instead.
+    */
+    void recallMorphTarget(int index);
+    
+    /** Audio thread, wait-free: takes the newest published set, returning false if there is none. */
+    bool pullCoefficients() noexcept { return coefficients.acquire(); }
+    
+    /** Audio thread: the set taken by the last successful pullCoefficients(). */
+    const ChainCoefficients& getCoefficients() const noexcept { return coefficients.getReadBuffer(); }
+    
+    /** Any thread: the tail of the newest published set (see getTailLengthSamples). */
+    double getTailLengthSeconds() const noexcept { return tailLengthSeconds.load(std::memory_order_relaxed); }
+    
+    /** Message thread, wait-free: the newest published set. Compare its version to tell whether anything changed. */
+    const CoefficientSnapshot& getSnapshot() noexcept
+    {
+        snapshots.acquire();
+        return snapshots.getReadBuffer();
+    }
+    
+private:
+    friend class CoefficientDesignerThread;
+    
+    void designDirtyBands();
+    
+    // With designLock held.
+    void publish();
+    
+    // Hands the last published set to the listener, without designLock held.
+    void notifyListener();
+    
+    // The designed set, morphed if the morph is engaged and its target has been set.
+    const ChainCoefficients& getMorphed();
+    
+    ChainSettings getSettings(const ChainParameters& source) const;
+    
+    // Settings as the prepared layout can run them.
+    ChainSettings matchLayout(ChainSettings settings) const noexcept;
+    
+    // Designs the targets whose settings changed since they were last designed, with designLock held.
+    void designMorphTargets();
+    
+    const ChainParameters& parameters;
+    
+    // Held by whichever thread is designing or publishing, and by the message thread's calls that change
+    // what is designed. Only ever contended by this designer's own work.
+    mutable juce::CriticalSection designLock;
+    
+    double sampleRate { 0 };
+    bool isStereo { true };
+    std::atomic<int> dirtyBands { 0 };
+    std::atomic<bool> morphDirty { false };
+    
+    // Laid out by prepare() for the host rate, and for the oversampled rate whenever the factor changes.
+    CoefficientTables hostRateTables, oversampledTables;
+    
+    ChainCoefficients designed, morphed;
+    TripleBuffer<ChainCoefficients> coefficients;
+    
+    std::atomic<float>* morphAmount { nullptr };
+    std::atomic<float>* morphTarget { nullptr };
+    std::array<std::optional<ChainSettings>, numMorphTargets> morphTargetSettings;
+    std::array<std::optional<ChainCoefficients>, numMorphTargets> morphTargets;
+    int dirtyMorphTargets { 0 };
+    
+    // A second handoff of the same sets, so the editor never takes one meant for the audio thread.
+    TripleBuffer<CoefficientSnapshot> snapshots;
+    juce::uint32 version { 0 };
+    
+    // What notifyListener() hands over: a copy, so the listener runs without designLock.
+    CoefficientSnapshot listenerSnapshot;
+    
+    std::atomic<double> tailLengthSeconds { 0.0 };
+    
+    Listener* listener { nullptr };
+    TimingHistogram* designTiming { nullptr };
+    
+    juce::SharedResourcePointer<CoefficientDesignerThread> designerThread;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientDesigner)
+};
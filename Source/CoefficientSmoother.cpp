@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    CoefficientSmoother.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "CoefficientSmoother.h"
+
+static BiquadCoefficients interpolate(const BiquadCoefficients& from, const BiquadCoefficients& to, double position) noexcept{
+    BiquadCoefficients result;
+    
+    for (size_t i = 0; i < result.size(); ++i)
+        result[i] = from[i] + (to[i] - from[i]) * position;
+    
+    return result;
+}
+
+// Frequencies and Qs move along a log scale, as their parameters do, so a sweep takes as long per octave.
+static float interpolateLog(float from, float to, double position) noexcept{
+    if (from <= 0.f || to <= 0.f)
+        return to;
+    
+    return static_cast<float>(from * std::pow(static_cast<double>(to) / from, position));
+}
+
+void CoefficientSmoother::prepare(double sampleRate){
+    designsPerRamp = juce::jmax(1, static_cast<int>(std::ceil(rampLengthSeconds * sampleRate / (controlInterval * stepsPerDesign))));
+    
+    hostRateTables.prepare(sampleRate);
+    
+    // Every factor "Oversampling" offers. The grids are shared and stay laid out, so updateChainCoefficients()
+    // only has to find them again when the factor changes.
+    for (auto factor : { 4, 2, 1 })
+        oversampledTables.prepare(sampleRate * factor);
+}
+
+void CoefficientSmoother::reset(const ChainCoefficients& coefficients) noexcept{
+    start = target = current = segmentStart = segmentEnd = coefficients;
+    
+    designsDone = 0;
+    stepsInSegment = stepsPerDesign;
+    stepsRemaining = 0;
+    samplesUntilNextStep = 0;
+}
+
+void CoefficientSmoother::setTarget(const ChainCoefficients& newTarget) noexcept{
+    // Coefficients for mid and side can't be interpolated with ones for left and right.
+    jassert(newTarget.stereoMode == current.stereoMode);
+    
+    // Mid-ramp, the running coefficients are on their way to the last design reached, so the new ramp
+    // starts from that design's settings.
+    auto startSettings = isSmoothing() ? segmentEnd.settings : current.settings;
+    auto canRampSettings = startSettings.has_value() && newTarget.settings.has_value();
+    target = newTarget;
+    
+    // A different slope means a different number of sections, which can't be interpolated.
+    if (current.lowCutSlope != target.lowCutSlope){
+        current.lowCut = target.lowCut;
+        current.lowCutSlope = target.lowCutSlope;
+        
+        if (canRampSettings)
+            startSettings->lowCutFreq = target.settings->lowCutFreq;
+    }
+    if (current.highCutSlope != target.highCutSlope){
+        current.highCut = target.highCut;
+        current.highCutSlope = target.highCutSlope;
+        
+        if (canRampSettings)
+            startSettings->highCutFreq = target.settings->highCutFreq;
+    }
+    
+    // Designs for different rates don't interpolate meaningfully either.
+    if (current.oversamplingFactor != target.oversamplingFactor){
+        current.parametric = target.parametric;
+        current.highCut = target.highCut;
+        current.oversamplingFactor = target.oversamplingFactor;
+        
+        if (canRampSettings){
+            startSettings->bands = target.settings->bands;
+            startSettings->highCutFreq = target.settings->highCutFreq;
+            startSettings->oversamplingFactor = target.settings->oversamplingFactor;
+        }
+    }
+    
+    start = current;
+    start.settings = startSettings;
+    
+    // The first step begins a new segment from the running coefficients.
+    designsDone = 0;
+    stepsInSegment = stepsPerDesign;
+    
+    // Stay on the existing control grid if a ramp is already running.
+    if (! isSmoothing())
+        samplesUntilNextStep = 0;
+    
+    stepsRemaining = designsPerRamp * stepsPerDesign;
+}
+
+const ChainCoefficients& CoefficientSmoother::step() noexcept{
+    jassert(isSmoothing());
+    
+    if (stepsInSegment == stepsPerDesign){
+        segmentStart = current;
+        
+        // The last design is the target itself, exactly as designed.
+        if (++designsDone == designsPerRamp)
+            segmentEnd = target;
+        else
+            designAt(designsDone / static_cast<double>(designsPerRamp), segmentEnd);
+        
+        stepsInSegment = 0;
+    }
+    
+    ++stepsInSegment;
+    --stepsRemaining;
+    
+    if (stepsInSegment == stepsPerDesign)
+        current = segmentEnd;
+    else
+        current = interpolateChainCoefficients(segmentStart, segmentEnd, stepsInSegment / static_cast<double>(stepsPerDesign));
+    
+    samplesUntilNextStep = controlInterval;
+    
+    return current;
+}
+
+void CoefficientSmoother::designAt(double position, ChainCoefficients& result) noexcept{
+    // Without settings at both ends, or across design methods, there's nothing to ramp but the coefficients.
+    if (! start.settings.has_value() || ! target.settings.has_value() || start.settings->designMethod != target.settings->designMethod){
+        result = interpolateChainCoefficients(start, target, position);
+        return;
+    }
+    
+    const auto& from = *start.settings;
+    auto settings = *target.settings;
+    
+    settings.lowCutFreq = interpolateLog(from.lowCutFreq, settings.lowCutFreq, position);
+    settings.highCutFreq = interpolateLog(from.highCutFreq, settings.highCutFreq, position);
+    
+    for (size_t i = 0; i < settings.bands.size(); ++i){
+        auto& band = settings.bands[i];
+        const auto& fromBand = from.bands[i];
+        
+        if (band.type == fromBand.type && band.channel == fromBand.channel){
+            band.frequency = interpolateLog(fromBand.frequency, band.frequency, position);
+            band.gainInDecibels = fromBand.gainInDecibels + static_cast<float>((band.gainInDecibels - fromBand.gainInDecibels) * position);
+            band.quality = interpolateLog(fromBand.quality, band.quality, position);
+        }
+    }
+    
+    // The target's slopes and rate, which start has already jumped to.
+    result = target;
+    updateChainCoefficients(result, settings, hostRateTables, oversampledTables, allBands);
+    
+    // A band changing type or channel has no settings in between, so only its coefficients move.
+    for (size_t i = 0; i < settings.bands.size(); ++i){
+        if (settings.bands[i].type == from.bands[i].type && settings.bands[i].channel == from.bands[i].channel)
+            continue;
+        
+        for (size_t channel = 0; channel < result.parametric.size(); ++channel)
+            result.parametric[channel][i] = interpolate(start.parametric[channel][i], target.parametric[channel][i], position);
+    }
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    CoefficientSmoother.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+#include "CoefficientTables.h"
+
+/**
+    Ramps a chain from its current coefficients towards a newly designed set
+    by ramping the settings they were designed from: frequencies and Qs along a
+    log scale, gains in dB. Every stepsPerDesign control steps the chain is
+    designed again from the tables for the settings reached so far, so each
+    design is a response some setting really has, and a large move never bulges
+    or dips through coefficients that belong to no setting at all.
+
+    Between two of those designs, which are close together, the normalised
+    biquad coefficients are interpolated once per control step. A straight line
+    between two stable biquads stays inside the (convex) stability triangle of
+    a1/a2, so every step is stable as well. The control grid carries across
+    blocks, so the step rate does not depend on the host's block size.
+
+    Anything with no settings in between is interpolated from one end of the
+    ramp to the other instead: a band changing type or channel, or a whole
+    set morphed from two designs (see CoefficientDesigner) or with a new design
+    method.
+*/
+class CoefficientSmoother
+{
+public:
+    /** Samples between coefficient updates while a ramp is running. */
+    static constexpr int controlInterval = 32;
+    
+    /** Control steps from one design at the ramped settings to the next. */
+    static constexpr int stepsPerDesign = 4;
+    
+    /** Length of one ramp from the old to the new design. */
+    static constexpr double rampLengthSeconds = 0.02;
+    
+    /** Message thread: lays out the tables the ramps are designed from, for the host rate and every
+        oversampled rate, so designing on the audio thread never allocates.
+    */
+    void prepare(double sampleRate);
+    
+    /** Audio thread: jumps straight to a set, with no ramp. */
+    void reset(const ChainCoefficients& coefficients) noexcept;
+    
+    /** Starts a new ramp from wherever the coefficients are now. Bands whose slope or rate changed jump instead.
+        The stereo mode must be the same as the current one's; a new mode needs reset().
+    */
+    void setTarget(const ChainCoefficients& newTarget) noexcept;
+    
+    bool isSmoothing() const noexcept { return stepsRemaining > 0; }
+    bool isStepDue() const noexcept { return samplesUntilNextStep == 0; }
+    int getSamplesUntilNextStep() const noexcept { return samplesUntilNextStep; }
+    
+    /** Moves one control step along the ramp and returns the coefficients to use until the next one. */
+    const ChainCoefficients& step() noexcept;
+    
+    /** Call after processing numSamples with the coefficients returned by the last step(). */
+    void advance(int numSamples) noexcept { samplesUntilNextStep -= numSamples; }
+    
+    /** The coefficients running now: those given to reset(), or returned by the last step(). */
+    const ChainCoefficients& getCurrent() const noexcept { return current; }
+    
+private:
+    // The set at a position (0 to 1) along the ramp.
+    void designAt(double position, ChainCoefficients& result) noexcept;
+    
+    CoefficientTables hostRateTables, oversampledTables;
+    
+    // The ends of the ramp. start holds the coefficients running when it began, and the settings of the
+    // last design they had reached.
+    ChainCoefficients start, target;
+    
+    // What is running, and the two designs the steps are interpolating between.
+    ChainCoefficients current, segmentStart, segmentEnd;
+    
+    int designsPerRamp { 1 }, designsDone { 0 }, stepsInSegment { stepsPerDesign };
+    int stepsRemaining { 0 }, samplesUntilNextStep { 0 };
+};
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    CoefficientTables.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "CoefficientTables.h"
+
+// sqrt(gain) and its square root, the terms makePeakFilter and the shelves use, over the band gain range.
+struct GainTable
+{
+    static constexpr double minDecibels = -24.0, maxDecibels = 24.0;
+    static constexpr double stepsPerDecibel = 20.0;
+    static constexpr int numSteps = static_cast<int>((maxDecibels - minDecibels) * stepsPerDecibel) + 1;
+
+    std::array<double, numSteps> amplitude {}, amplitudeRoot {};
+
+    GainTable(){
+        for (int i = 0; i < numSteps; ++i){
+            auto decibels = minDecibels + i / stepsPerDecibel;
+            amplitude[static_cast<size_t>(i)] = std::pow(10.0, decibels / 40.0);
+            amplitudeRoot[static_cast<size_t>(i)] = std::pow(10.0, decibels / 80.0);
+        }
+    }
+
+    void lookUp(double decibels, double& a, double& aRoot) const noexcept{
+        auto position = (decibels - minDecibels) * stepsPerDecibel;
+
+        if (position < 0.0 || position > numSteps - 1){
+            a = std::sqrt(juce::Decibels::decibelsToGain(decibels, -300.0));
+            aRoot = std::sqrt(a);
+            return;
+        }
+
+        auto index = juce::jmin(static_cast<int>(position), numSteps - 2);
+        auto fraction = position - index;
+        auto i = static_cast<size_t>(index);
+
+        a = amplitude[i] + fraction * (amplitude[i + 1] - amplitude[i]);
+        aRoot = amplitudeRoot[i] + fraction * (amplitudeRoot[i + 1] - amplitudeRoot[i]);
+    }
+};
+
+static const GainTable& getGainTable(){
+    static const GainTable table;
+    return table;
+}
+
+// Divides through by a0.
+static BiquadCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2) noexcept{
+    auto a0Inv = 1.0 / a0;
+    return { b0 * a0Inv, b1 * a0Inv, b2 * a0Inv, 1.0, a1 * a0Inv, a2 * a0Inv };
+}
+
+// The RBJ cookbook designs, from sin(w) and cos(w). They have the same responses as
+// IIR::ArrayCoefficients' versions, which prewarp with tan(w / 2) instead.
+static BiquadCoefficients makeHighPass(double sinW, double cosW, double quality) noexcept{
+    auto alpha = sinW / (2.0 * quality);
+    auto b = 0.5 * (1.0 + cosW);
+    return normalise(b, -2.0 * b, b, 1.0 + alpha, -2.0 * cosW, 1.0 - alpha);
+}
+
+static BiquadCoefficients makeLowPass(double sinW, double cosW, double quality) noexcept{
+    auto alpha = sinW / (2.0 * quality);
+    auto b = 0.5 * (1.0 - cosW);
+    return normalise(b, 2.0 * b, b, 1.0 + alpha, -2.0 * cosW, 1.0 - alpha);
+}
+
+static BiquadCoefficients makeBell(double sinW, double cosW, double quality, double a) noexcept{
+    auto alpha = sinW / (2.0 * quality);
+    return normalise(1.0 + alpha * a, -2.0 * cosW, 1.0 - alpha * a, 1.0 + alpha / a, -2.0 * cosW, 1.0 - alpha / a);
+}
+
+static BiquadCoefficients makeNotch(double sinW, double cosW, double quality) noexcept{
+    auto alpha = sinW / (2.0 * quality);
+    return normalise(1.0, -2.0 * cosW, 1.0, 1.0 + alpha, -2.0 * cosW, 1.0 - alpha);
+}
+
+static BiquadCoefficients makeLowShelf(double sinW, double cosW, double quality, double a, double aRoot) noexcept{
+    auto aMinus1 = a - 1.0, aPlus1 = a + 1.0;
+    auto beta = sinW * aRoot / quality;
+    auto aMinus1TimesCos = aMinus1 * cosW;
+
+    return normalise(a * (aPlus1 - aMinus1TimesCos + beta), a * 2.0 * (aMinus1 - aPlus1 * cosW), a * (aPlus1 - aMinus1TimesCos - beta),
+                     aPlus1 + aMinus1TimesCos + beta, -2.0 * (aMinus1 + aPlus1 * cosW), aPlus1 + aMinus1TimesCos - beta);
+}
+
+static BiquadCoefficients makeHighShelf(double sinW, double cosW, double quality, double a, double aRoot) noexcept{
+    auto aMinus1 = a - 1.0, aPlus1 = a + 1.0;
+    auto beta = sinW * aRoot / quality;
+    auto aMinus1TimesCos = aMinus1 * cosW;
+
+    return normalise(a * (aPlus1 + aMinus1TimesCos + beta), a * -2.0 * (aMinus1 + aPlus1 * cosW), a * (aPlus1 + aMinus1TimesCos - beta),
+                     aPlus1 - aMinus1TimesCos + beta, 2.0 * (aMinus1 - aPlus1 * cosW), aPlus1 - aMinus1TimesCos - beta);
+}
+
+void CoefficientTables::prepare(double newSampleRate){
+    if (newSampleRate == getSampleRate())
+        return;
+
+    getGainTable();
+    grid = &cache->getFrequencyGrid(newSampleRate);
+}
+
+bool CoefficientTables::findFrequency(double frequency, int& index, double& fraction) const noexcept{
+    if (grid == nullptr || grid->numUsableFrequencies < 2 || frequency < minFrequency)
+        return false;
+
+    auto position = std::log(frequency / minFrequency) * grid->pointsPerLog;
+
+    if (position > grid->numUsableFrequencies - 1)
+        return false;
+
+    index = juce::jmin(static_cast<int>(position), grid->numUsableFrequencies - 2);
+    fraction = position - index;
+    return true;
+}
+
+BiquadCoefficients CoefficientTables::makeBandCoefficients(const BandSettings& band, DesignMethod designMethod){
+    if (band.type == BandType_Off)
+        return identityCoefficients;
+
+    auto matched = designMethod == DesignMethod_Matched;
+    int index;
+    double fraction;
+
+    if ((matched && (band.type == BandType_Bell || band.type == BandType_LowCut || band.type == BandType_HighCut))
+          || ! findFrequency(band.frequency, index, fraction))
+        return cache->getBandCoefficients(band, designMethod, getSampleRate());
+
+    const auto& sinW = grid->sinW;
+    const auto& cosW = grid->cosW;
+    auto i = static_cast<size_t>(index);
+    auto s = sinW[i] + fraction * (sinW[i + 1] - sinW[i]);
+    auto c = cosW[i] + fraction * (cosW[i + 1] - cosW[i]);
+    auto quality = static_cast<double>(band.quality);
+
+    double a, aRoot;
+    getGainTable().lookUp(band.gainInDecibels, a, aRoot);
+
+    switch (band.type){
+        case BandType_Bell:      return makeBell(s, c, quality, a);
+        case BandType_LowShelf:  return makeLowShelf(s, c, quality, a, aRoot);
+        case BandType_HighShelf: return makeHighShelf(s, c, quality, a, aRoot);
+        case BandType_Notch:     return makeNotch(s, c, quality);
+        case BandType_LowCut:    return makeHighPass(s, c, quality);
+        case BandType_HighCut:   return makeLowPass(s, c, quality);
+        case BandType_Off:
+        default:                 return identityCoefficients;
+    }
+}
+
+CutCoefficients CoefficientTables::makeLowCutCoefficients(const ChainSettings& chainSettings){
+    // At the edge of its range the cut is off, exactly as the direct design has it.
+    if (chainSettings.lowCutFreq <= minCutFrequency)
+        return ::makeLowCutCoefficients(chainSettings, getSampleRate());
+
+    return makeCutCoefficients(true, chainSettings.lowCutFreq, chainSettings.lowCutSlope, chainSettings.designMethod);
+}
+
+CutCoefficients CoefficientTables::makeHighCutCoefficients(const ChainSettings& chainSettings){
+    if (chainSettings.highCutFreq >= maxCutFrequency)
+        return ::makeHighCutCoefficients(chainSettings, getSampleRate());
+
+    return makeCutCoefficients(false, chainSettings.highCutFreq, chainSettings.highCutSlope, chainSettings.designMethod);
+}
+
+CutCoefficients CoefficientTables::makeCutCoefficients(bool highPass, float frequency, Slope slope, DesignMethod designMethod){
+    int index;
+    double fraction;
+
+    if (! findFrequency(frequency, index, fraction)){
+        ChainSettings settings;
+        settings.lowCutFreq = settings.highCutFreq = frequency;
+        settings.lowCutSlope = settings.highCutSlope = slope;
+        settings.designMethod = designMethod;
+
+        return highPass ? ::makeLowCutCoefficients(settings, getSampleRate()) : ::makeHighCutCoefficients(settings, getSampleRate());
+    }
+
+    CutCoefficients coefficients {};
+    auto i = static_cast<size_t>(index);
+
+    if (designMethod == DesignMethod_Matched){
+        const auto* table = grid->getMatchedCutTable(highPass, slope);
+
+        for (int section = 0; section <= slope; ++section){
+            const auto& lower = table[static_cast<size_t>(section * numFrequencies) + i];
+            const auto& upper = table[static_cast<size_t>(section * numFrequencies) + i + 1];
+            auto& c = coefficients[static_cast<size_t>(section)];
+
+            for (size_t k = 0; k < c.size(); ++k)
+                c[k] = lower[k] + fraction * (upper[k] - lower[k]);
+        }
+
+        return coefficients;
+    }
+
+    const auto& sinW = grid->sinW;
+    const auto& cosW = grid->cosW;
+    auto s = sinW[i] + fraction * (sinW[i + 1] - sinW[i]);
+    auto c = cosW[i] + fraction * (cosW[i + 1] - cosW[i]);
+    const auto& qualities = getButterworthQualities(slope);
+
+    for (int section = 0; section <= slope; ++section){
+        auto quality = qualities[static_cast<size_t>(section)];
+        coefficients[static_cast<size_t>(section)] = highPass ? makeHighPass(s, c, quality) : makeLowPass(s, c, quality);
+    }
+
+    return coefficients;
+}
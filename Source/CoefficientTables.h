@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    CoefficientTables.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+#include "CoefficientCache.h"
+
+/**
+    Designs a chain's bands from tables laid out for one sample rate, so that
+    automation moving several bands every control period doesn't pay for a full
+    design each time.
+
+    sin(w) and cos(w) are tabulated over a log-frequency grid for each rate, and
+    the gain terms over the band gain range, once per process. Every bilinear
+    design is then a table lookup, an interpolation and a handful of multiply-adds
+    on the RBJ terms, with no trig, pow or exp.
+
+    Matched cuts place their poles with exp and cos of the section Q, which is fixed
+    for a given Slope, so each Slope's sections are designed once over the whole
+    grid, the first time that Slope is used at this rate, and read back by
+    interpolating between the two neighbouring grid points. Neighbouring sections
+    are both stable, and so is any blend of the two.
+
+    Anything the tables don't cover (frequencies off the grid or above Nyquist,
+    matched bells and the single-section matched cuts, whose pole Q follows the
+    band's Q and gain) is designed as makeBandCoefficients() would, and kept in
+    the cache, so each distinct band is designed once per process until newer
+    ones replace it.
+
+    The grids and those designs live in the CoefficientCache every instance shares,
+    so this only holds a pointer to its rate's grid and is cheap to make.
+*/
+class CoefficientTables
+{
+public:
+    /** The grid spans the band and cut frequency ranges, about 400 points per octave. */
+    static constexpr int numFrequencies = CoefficientCache::FrequencyGrid::numFrequencies;
+    static constexpr double minFrequency = CoefficientCache::FrequencyGrid::minFrequency,
+                            maxFrequency = CoefficientCache::FrequencyGrid::maxFrequency;
+
+    /** Picks up the shared grid for a new rate, which allocates only if no instance has used that rate yet. */
+    void prepare(double newSampleRate);
+
+    double getSampleRate() const noexcept { return grid != nullptr ? grid->sampleRate : 0.0; }
+
+    /** Same results as the free functions in FilterChain.h, to within the tables' interpolation. */
+    BiquadCoefficients makeBandCoefficients(const BandSettings& band, DesignMethod designMethod);
+    CutCoefficients makeLowCutCoefficients(const ChainSettings& chainSettings);
+    CutCoefficients makeHighCutCoefficients(const ChainSettings& chainSettings);
+
+private:
+    // Where a frequency falls on the grid. Returns false if it's off the part that's below Nyquist.
+    bool findFrequency(double frequency, int& index, double& fraction) const noexcept;
+
+    CutCoefficients makeCutCoefficients(bool highPass, float frequency, Slope slope, DesignMethod designMethod);
+
+    juce::SharedResourcePointer<CoefficientCache> cache;
+    const CoefficientCache::FrequencyGrid* grid { nullptr };
+};
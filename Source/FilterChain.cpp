@@ -0,0 +1,387 @@
+/*
+  ==============================================================================
+
+    FilterChain.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "FilterChain.h"
+
+juce::String getBandParameterID(int band, const juce::String& name){
+    if (band == 0)
+        return "Peak " + name;
+    
+    return "Band " + juce::String(band + 1) + " " + name;
+}
+
+ChainParameters::ChainParameters(juce::AudioProcessorValueTreeState &apvts) :
+    ChainParameters([&apvts](const juce::String& parameterID){ return apvts.getRawParameterValue(parameterID); })
+{
+}
+
+ChainParameters::ChainParameters(const std::function<std::atomic<float>*(const juce::String& parameterID)>& getRawValue) :
+    lowCutFreq(getRawValue("LowCut Freq")),
+    highCutFreq(getRawValue("HighCut Freq")),
+    lowCutSlope(getRawValue("LowCut Slope")),
+    highCutSlope(getRawValue("HighCut Slope")),
+    oversampling(getRawValue("Oversampling")),
+    designMethod(getRawValue("Filter Design")),
+    stereoMode(getRawValue("Stereo Mode"))
+{
+    for (int i = 0; i < maxParametricBands; ++i){
+        auto& band = bands[static_cast<size_t>(i)];
+        
+        band.type = getRawValue(getBandParameterID(i, "Type"));
+        band.frequency = getRawValue(getBandParameterID(i, "Freq"));
+        band.gain = getRawValue(getBandParameterID(i, "Gain"));
+        band.quality = getRawValue(getBandParameterID(i, "Quality"));
+        band.channel = getRawValue(getBandParameterID(i, "Channel"));
+    }
+}
+
+ChainSettings getChainSettings(const ChainParameters &parameters){
+    ChainSettings settings;
+    
+    settings.lowCutFreq = parameters.lowCutFreq->load();
+    settings.highCutFreq = parameters.highCutFreq->load();
+    
+    for (size_t i = 0; i < settings.bands.size(); ++i){
+        settings.bands[i].type = static_cast<BandType>(parameters.bands[i].type->load());
+        settings.bands[i].frequency = parameters.bands[i].frequency->load();
+        settings.bands[i].gainInDecibels = parameters.bands[i].gain->load();
+        settings.bands[i].quality = parameters.bands[i].quality->load();
+        settings.bands[i].channel = static_cast<BandChannel>(parameters.bands[i].channel->load());
+    }
+    
+    settings.lowCutSlope = static_cast<Slope>(parameters.lowCutSlope->load());
+    settings.highCutSlope = static_cast<Slope>(parameters.highCutSlope->load());
+    settings.oversamplingFactor = 1 << static_cast<int>(parameters.oversampling->load());
+    settings.designMethod = static_cast<DesignMethod>(parameters.designMethod->load());
+    settings.stereoMode = static_cast<StereoMode>(parameters.stereoMode->load());
+
+    return settings;
+}
+
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState &apvts){
+    return getChainSettings(ChainParameters(apvts));
+}
+
+// Divides through by a0, so sets of coefficients can be interpolated directly.
+static BiquadCoefficients normalise(BiquadCoefficients coefficients){
+    auto a0Inv = 1.0 / coefficients[3];
+    
+    for (auto& c : coefficients)
+        c *= a0Inv;
+    
+    return coefficients;
+}
+
+//==============================================================================
+// Matched second-order designs, after M. Vicanek, "Matched Second Order Digital Filters" (2016).
+// The poles are the exact images of the analog poles; the zeros are then chosen so the digital
+// magnitude matches the analog one at DC, at the centre frequency and at Nyquist.
+namespace Matched
+{
+    struct Poles
+    {
+        double a1, a2;
+        double A0, A1, A2;      // pole polynomial terms of |A(e^jw)|^2
+        double phi0, phi1, phi2;
+    };
+    
+    static Poles makePoles(double frequency, double quality, double sampleRate){
+        auto w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        auto zeta = 1.0 / (2.0 * quality);
+        
+        Poles p;
+        p.a2 = std::exp(-2.0 * zeta * w0);
+        p.a1 = zeta <= 1.0 ? -2.0 * std::exp(-zeta * w0) * std::cos(std::sqrt(1.0 - zeta * zeta) * w0)
+                           : -2.0 * std::exp(-zeta * w0) * std::cosh(std::sqrt(zeta * zeta - 1.0) * w0);
+        
+        p.A0 = std::pow(1.0 + p.a1 + p.a2, 2.0);
+        p.A1 = std::pow(1.0 - p.a1 + p.a2, 2.0);
+        p.A2 = -4.0 * p.a2;
+        
+        p.phi1 = std::pow(std::sin(w0 / 2.0), 2.0);
+        p.phi0 = 1.0 - p.phi1;
+        p.phi2 = 4.0 * p.phi0 * p.phi1;
+        
+        return p;
+    }
+    
+    static BiquadCoefficients makeLowPass(double sampleRate, double frequency, double quality){
+        auto p = makePoles(frequency, quality, sampleRate);
+        
+        auto r1 = (p.A0 * p.phi0 + p.A1 * p.phi1 + p.A2 * p.phi2) * quality * quality;
+        auto B0 = p.A0;
+        auto B1 = (r1 - B0 * p.phi0) / p.phi1;
+        
+        auto b0 = 0.5 * (std::sqrt(B0) + std::sqrt(juce::jmax(0.0, B1)));
+        return { b0, std::sqrt(B0) - b0, 0.0, 1.0, p.a1, p.a2 };
+    }
+    
+    static BiquadCoefficients makeHighPass(double sampleRate, double frequency, double quality){
+        auto p = makePoles(frequency, quality, sampleRate);
+        
+        auto b0 = std::sqrt(p.A0 * p.phi0 + p.A1 * p.phi1 + p.A2 * p.phi2) * quality / (4.0 * p.phi1);
+        return { b0, -2.0 * b0, b0, 1.0, p.a1, p.a2 };
+    }
+    
+    // quality and gain follow IIR::Coefficients::makePeakFilter, whose poles have a Q of quality * sqrt(gain).
+    static BiquadCoefficients makePeakFilter(double sampleRate, double frequency, double quality, double gain){
+        auto poleQuality = quality * std::sqrt(gain);
+        auto p = makePoles(frequency, poleQuality, sampleRate);
+        
+        auto r1 = (p.A0 * p.phi0 + p.A1 * p.phi1 + p.A2 * p.phi2) * gain * gain;
+        auto r2 = (-p.A0 + p.A1 + 4.0 * (p.phi0 - p.phi1) * p.A2) * gain * gain;
+        
+        auto B0 = p.A0;
+        auto B2 = (r1 - r2 * p.phi1 - B0) / (4.0 * p.phi1 * p.phi1);
+        auto B1 = r2 + B0 + 4.0 * (p.phi1 - p.phi0) * B2;
+        
+        auto w = 0.5 * (std::sqrt(B0) + std::sqrt(juce::jmax(0.0, B1)));
+        auto b0 = 0.5 * (w + std::sqrt(juce::jmax(0.0, w * w + B2)));
+        auto b1 = 0.5 * (std::sqrt(B0) - std::sqrt(juce::jmax(0.0, B1)));
+        
+        return { b0, b1, -B2 / (4.0 * b0), 1.0, p.a1, p.a2 };
+    }
+}
+
+//==============================================================================
+BiquadCoefficients makeBandCoefficients(const BandSettings& band, DesignMethod designMethod, double sampleRate){
+    using Design = juce::dsp::IIR::ArrayCoefficients<double>;
+    
+    auto frequency = static_cast<double>(band.frequency);
+    auto quality = static_cast<double>(band.quality);
+    auto gain = juce::Decibels::decibelsToGain(static_cast<double>(band.gainInDecibels));
+    auto matched = designMethod == DesignMethod_Matched;
+    
+    // There are no matched shelves or notches, so those stay bilinear whichever method is picked.
+    switch (band.type){
+        case BandType_Bell:
+            return matched ? Matched::makePeakFilter(sampleRate, frequency, quality, gain)
+                           : normalise(Design::makePeakFilter(sampleRate, frequency, quality, gain));
+        case BandType_LowShelf:
+            return normalise(Design::makeLowShelf(sampleRate, frequency, quality, gain));
+        case BandType_HighShelf:
+            return normalise(Design::makeHighShelf(sampleRate, frequency, quality, gain));
+        case BandType_Notch:
+            return normalise(Design::makeNotch(sampleRate, frequency, quality));
+        case BandType_LowCut:
+            return matched ? Matched::makeHighPass(sampleRate, frequency, quality)
+                           : normalise(Design::makeHighPass(sampleRate, frequency, quality));
+        case BandType_HighCut:
+            return matched ? Matched::makeLowPass(sampleRate, frequency, quality)
+                           : normalise(Design::makeLowPass(sampleRate, frequency, quality));
+        case BandType_Off:
+        default:
+            return identityCoefficients;
+    }
+}
+
+bool isOnChannel(const BandSettings& band, StereoMode stereoMode, int channel) noexcept{
+    if (stereoMode == StereoMode_Linked || band.channel == BandChannel_Both)
+        return true;
+    
+    return band.channel == (channel == 0 ? BandChannel_First : BandChannel_Second);
+}
+
+void placeBand(std::array<ParametricCoefficients, 2>& parametric, size_t band, const BiquadCoefficients& design,
+               const BandSettings& settings, StereoMode stereoMode) noexcept{
+    for (int channel = 0; channel < 2; ++channel)
+        parametric[static_cast<size_t>(channel)][band] = isOnChannel(settings, stereoMode, channel) ? design : identityCoefficients;
+}
+
+const std::array<double, 4>& getButterworthQualities(Slope slope){
+    // Same section Qs as FilterDesign's even-order Butterworth designs, worked out once for every slope.
+    static const auto qualities = []{
+        std::array<std::array<double, 4>, 4> table {};
+        
+        for (int s = 0; s < 4; ++s){
+            auto order = 2 * (s + 1);
+            
+            for (int i = 0; i <= s; ++i)
+                table[static_cast<size_t>(s)][static_cast<size_t>(i)] = 1.0 / (2.0 * std::cos((2.0 * i + 1.0) * juce::MathConstants<double>::pi / (order * 2.0)));
+        }
+        
+        return table;
+    }();
+    
+    return qualities[static_cast<size_t>(slope)];
+}
+
+bool isIdentity(const BiquadCoefficients& c) noexcept{
+    constexpr double tolerance = 1.0e-6;
+    
+    return std::abs(c[0] - 1.0) < tolerance && std::abs(c[1] - c[4]) < tolerance && std::abs(c[2] - c[5]) < tolerance;
+}
+
+CutCoefficients makeLowCutCoefficients(const ChainSettings& chainSettings, double sampleRate){
+    CutCoefficients coefficients{};
+    
+    if (chainSettings.lowCutFreq <= minCutFrequency){
+        coefficients.fill(identityCoefficients);
+        return coefficients;
+    }
+    
+    const auto& qualities = getButterworthQualities(chainSettings.lowCutSlope);
+    
+    for (int i = 0; i <= chainSettings.lowCutSlope; ++i){
+        auto quality = qualities[static_cast<size_t>(i)];
+        
+        if (chainSettings.designMethod == DesignMethod_Matched)
+            coefficients[i] = Matched::makeHighPass(sampleRate, chainSettings.lowCutFreq, quality);
+        else
+            coefficients[i] = normalise(juce::dsp::IIR::ArrayCoefficients<double>::makeHighPass(sampleRate, static_cast<double>(chainSettings.lowCutFreq), quality));
+    }
+    
+    return coefficients;
+}
+
+CutCoefficients makeHighCutCoefficients(const ChainSettings& chainSettings, double sampleRate){
+    CutCoefficients coefficients{};
+    
+    if (chainSettings.highCutFreq >= maxCutFrequency){
+        coefficients.fill(identityCoefficients);
+        return coefficients;
+    }
+    
+    const auto& qualities = getButterworthQualities(chainSettings.highCutSlope);
+    
+    for (int i = 0; i <= chainSettings.highCutSlope; ++i){
+        auto quality = qualities[static_cast<size_t>(i)];
+        
+        if (chainSettings.designMethod == DesignMethod_Matched)
+            coefficients[i] = Matched::makeLowPass(sampleRate, chainSettings.highCutFreq, quality);
+        else
+            coefficients[i] = normalise(juce::dsp::IIR::ArrayCoefficients<double>::makeLowPass(sampleRate, static_cast<double>(chainSettings.highCutFreq), quality));
+    }
+    
+    return coefficients;
+}
+
+// juce::dsp::IIR versions of the designs, for anything still running IIR::Filters. They follow the design method too.
+static Coefficients makeFilterCoefficients(const BiquadCoefficients& c){
+    return new juce::dsp::IIR::Coefficients<float>(static_cast<float>(c[0]), static_cast<float>(c[1]), static_cast<float>(c[2]),
+                                                   static_cast<float>(c[3]), static_cast<float>(c[4]), static_cast<float>(c[5]));
+}
+
+Coefficients makeBandFilter(const BandSettings& band, DesignMethod designMethod, double sampleRate){
+    return makeFilterCoefficients(makeBandCoefficients(band, designMethod, sampleRate));
+}
+
+static CutFilterCoefficients makeCutFilter(const CutCoefficients& coefficients, Slope slope){
+    CutFilterCoefficients filters;
+    
+    for (int i = 0; i <= slope; ++i)
+        filters.add(makeFilterCoefficients(coefficients[static_cast<size_t>(i)]));
+    
+    return filters;
+}
+
+CutFilterCoefficients makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate){
+    return makeCutFilter(makeLowCutCoefficients(chainSettings, sampleRate), chainSettings.lowCutSlope);
+}
+
+CutFilterCoefficients makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate){
+    return makeCutFilter(makeHighCutCoefficients(chainSettings, sampleRate), chainSettings.highCutSlope);
+}
+
+ChainCoefficients makeChainCoefficients(const ChainSettings& chainSettings, double sampleRate){
+    ChainCoefficients coefficients;
+    updateChainCoefficients(coefficients, chainSettings, sampleRate, allBands);
+    
+    return coefficients;
+}
+
+void updateChainCoefficients(ChainCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate, int bandsToUpdate){
+    DirectDesigns hostRateDesigns { sampleRate }, oversampledDesigns;
+    updateChainCoefficients(coefficients, chainSettings, hostRateDesigns, oversampledDesigns, bandsToUpdate);
+}
+
+ChainCoefficients interpolateChainCoefficients(const ChainCoefficients& from, const ChainCoefficients& to, double amount){
+    auto result = amount < 0.5 ? from : to;
+    result.settings.reset();
+    
+    // Changing stereo mode resets the cascades, which mid-glide would click, so across modes the source's mode
+    // and parametric bands are kept all the way, with the high cut and oversampling factor they're designed at.
+    if (from.stereoMode != to.stereoMode){
+        result.parametric = from.parametric;
+        result.stereoMode = from.stereoMode;
+        result.highCut = from.highCut;
+        result.highCutSlope = from.highCutSlope;
+        result.oversamplingFactor = from.oversamplingFactor;
+    }
+    
+    auto blend = [amount](BiquadCoefficients& blended, const BiquadCoefficients& a, const BiquadCoefficients& b){
+        for (size_t i = 0; i < blended.size(); ++i)
+            blended[i] = a[i] + (b[i] - a[i]) * amount;
+    };
+    
+    if (from.lowCutSlope == to.lowCutSlope)
+        for (size_t i = 0; i < result.lowCut.size(); ++i)
+            blend(result.lowCut[i], from.lowCut[i], to.lowCut[i]);
+    
+    if (from.oversamplingFactor == to.oversamplingFactor){
+        if (from.stereoMode == to.stereoMode)
+            for (size_t channel = 0; channel < result.parametric.size(); ++channel)
+                for (size_t i = 0; i < result.parametric[channel].size(); ++i)
+                    blend(result.parametric[channel][i], from.parametric[channel][i], to.parametric[channel][i]);
+        
+        if (from.highCutSlope == to.highCutSlope)
+            for (size_t i = 0; i < result.highCut.size(); ++i)
+                blend(result.highCut[i], from.highCut[i], to.highCut[i]);
+    }
+    
+    return result;
+}
+
+// Samples for one section's impulse response to decay by the given factor, from its largest pole radius.
+static double getDecaySamples(const BiquadCoefficients& c, double decay){
+    if (isIdentity(c))
+        return 0.0;
+    
+    auto a1 = c[4], a2 = c[5];
+    auto discriminant = a1 * a1 - 4.0 * a2;
+    
+    // Complex poles share a radius of sqrt(a2); real ones are the roots of z^2 + a1 z + a2.
+    auto radius = discriminant < 0.0 ? std::sqrt(a2)
+                                     : 0.5 * (std::abs(a1) + std::sqrt(discriminant));
+    
+    if (radius <= 0.0)
+        return 2.0;
+    
+    jassert(radius < 1.0);
+    
+    return std::log(decay) / std::log(juce::jmin(radius, 1.0 - 1.0e-9));
+}
+
+double getTailLengthSamples(const ChainCoefficients& coefficients){
+    constexpr double decay = 1.0e-6; // -120 dB
+    
+    double hostRateSamples = 0.0, oversampledSamples = 0.0;
+    
+    for (int i = 0; i <= coefficients.lowCutSlope; ++i)
+        hostRateSamples += getDecaySamples(coefficients.lowCut[static_cast<size_t>(i)], decay);
+    
+    // Whichever channel of the pair rings for longer sets the tail.
+    double parametricSamples = 0.0;
+    
+    for (const auto& channel : coefficients.parametric){
+        double channelSamples = 0.0;
+        
+        for (const auto& band : channel)
+            channelSamples += getDecaySamples(band, decay);
+        
+        parametricSamples = juce::jmax(parametricSamples, channelSamples);
+    }
+    
+    oversampledSamples += parametricSamples;
+    
+    for (int i = 0; i <= coefficients.highCutSlope; ++i)
+        oversampledSamples += getDecaySamples(coefficients.highCut[static_cast<size_t>(i)], decay);
+    
+    return hostRateSamples + oversampledSamples / coefficients.oversamplingFactor;
+}
@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    FilterChain.h
+    Created: 17 Oct 2026
+
+    Settings, filter chain types and coefficient design shared by the
+    processor, the coefficient designer and the editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum Slope{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+// Bilinear follows the textbook (RBJ) designs, which cramp towards Nyquist. Matched
+// places the poles exactly and fits the zeros to the analog magnitude response up to
+// Nyquist (after Vicanek), so high bands keep their shape without oversampling.
+enum DesignMethod{
+    DesignMethod_Bilinear,
+    DesignMethod_Matched
+};
+
+// What each parametric band does. Cuts here are single 12 dB/Oct sections; the dedicated low and
+// high cuts cover the steeper slopes.
+enum BandType{
+    BandType_Off,
+    BandType_Bell,
+    BandType_LowShelf,
+    BandType_HighShelf,
+    BandType_Notch,
+    BandType_LowCut,
+    BandType_HighCut
+};
+
+// How the two channels of a stereo bus are filtered. Linked runs every band on both; Mid/Side and
+// Dual Mono let each band run on one channel of the pair only (see BandChannel).
+enum StereoMode{
+    StereoMode_Linked,
+    StereoMode_MidSide,
+    StereoMode_DualMono
+};
+
+// The channels a band filters outside linked mode: left or right in Dual Mono, mid or side in Mid/Side.
+enum BandChannel{
+    BandChannel_Both,
+    BandChannel_First,
+    BandChannel_Second
+};
+
+// The first band is the original "Peak" band; the rest start off, so they cost nothing until used.
+constexpr int maxParametricBands = 16;
+
+struct BandSettings
+{
+    BandType type { BandType::BandType_Off };
+    float frequency { 750.f }, gainInDecibels { 0 }, quality { 1.f };
+    BandChannel channel { BandChannel::BandChannel_Both };
+};
+
+// "Peak Freq" and so on for the first band, "Band 2 Freq" onwards for the others.
+juce::String getBandParameterID(int band, const juce::String& name);
+
+struct ChainSettings
+{
+    std::array<BandSettings, maxParametricBands> bands {};
+    float lowCutFreq { 0 }, highCutFreq { 0 };
+    
+    Slope lowCutSlope{ Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+    
+    // The parametric bands and high cut run at this multiple of the host rate; the low cut never needs to.
+    int oversamplingFactor { 1 };
+    
+    DesignMethod designMethod { DesignMethod::DesignMethod_Bilinear };
+    
+    StereoMode stereoMode { StereoMode::StereoMode_Linked };
+};
+
+// Raw parameter handles looked up once, so the audio thread never does a string-keyed search.
+struct ChainParameters
+{
+    explicit ChainParameters(juce::AudioProcessorValueTreeState &apvts);
+    
+    // Values kept anywhere else, such as a stored snapshot's, looked up by parameter ID.
+    explicit ChainParameters(const std::function<std::atomic<float>*(const juce::String& parameterID)>& getRawValue);
+    
+    struct Band
+    {
+        std::atomic<float> *type, *frequency, *gain, *quality, *channel;
+    };
+    
+    std::array<Band, maxParametricBands> bands;
+    std::atomic<float> *lowCutFreq, *highCutFreq, *lowCutSlope, *highCutSlope, *oversampling, *designMethod, *stereoMode;
+};
+
+ChainSettings getChainSettings(const ChainParameters &parameters);
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState &apvts);
+
+// The three groups of sections in a chain. Peak covers every parametric band.
+enum ChainPossitions{
+    LowCut,
+    Peak,
+    HighCut
+};
+
+// One bit per ChainPossitions entry, used to track which bands need redesigning.
+constexpr int getBandMask(ChainPossitions position) { return 1 << position; }
+constexpr int allBands = getBandMask(LowCut) | getBandMask(Peak) | getBandMask(HighCut);
+
+using Coefficients = juce::dsp::IIR::Coefficients<float>::Ptr;
+
+// Raw biquad coefficients (b0, b1, b2, a0, a1, a2), normalised so that a0 == 1, that can be designed without touching the heap.
+// They're designed in double precision and rounded only when loaded into a float kernel.
+using BiquadCoefficients = std::array<double, 6>;
+using CutCoefficients = std::array<BiquadCoefficients, 4>;
+
+// A section that passes its input straight through. Bands that are off are designed as these, and so
+// are the cuts at the ends of their ranges (a low cut at minCutFrequency, a high cut at maxCutFrequency),
+// where they count as off. The cascades skip any section that is one, so a chain left at its defaults,
+// with both cuts at their ends and every band flat, isn't processed at all.
+constexpr BiquadCoefficients identityCoefficients { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+constexpr float minCutFrequency = 20.f, maxCutFrequency = 20000.f;
+
+// True if the numerator matches the denominator to within a few parts per million, as a peak
+// at 0 dB does, so the section's response is flat.
+bool isIdentity(const BiquadCoefficients& coefficients) noexcept;
+
+// The Qs of a Butterworth cut's sections, lowest first; only the first slope + 1 are used.
+const std::array<double, 4>& getButterworthQualities(Slope slope);
+
+Coefficients makeBandFilter(const BandSettings& band, DesignMethod designMethod, double sampleRate);
+
+BiquadCoefficients makeBandCoefficients(const BandSettings& band, DesignMethod designMethod, double sampleRate);
+CutCoefficients makeLowCutCoefficients(const ChainSettings& chainSettings, double sampleRate);
+CutCoefficients makeHighCutCoefficients(const ChainSettings& chainSettings, double sampleRate);
+
+// One entry per active section, as FilterDesign's Butterworth methods return them.
+using CutFilterCoefficients = juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>>;
+
+CutFilterCoefficients makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate);
+CutFilterCoefficients makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate);
+
+using ParametricCoefficients = std::array<BiquadCoefficients, maxParametricBands>;
+
+// Whether a band filters the given channel of the pair: 0 for left or mid, 1 for right or side.
+bool isOnChannel(const BandSettings& band, StereoMode stereoMode, int channel) noexcept;
+
+// The same band's design for each channel of the pair: the design where the band filters that channel, identity where it doesn't.
+void placeBand(std::array<ParametricCoefficients, 2>& parametric, size_t band, const BiquadCoefficients& design,
+               const BandSettings& settings, StereoMode stereoMode) noexcept;
+
+// A complete coefficient set for one chain, designed in one go so it can be handed over as a unit.
+// Bands that are off are identity sections, which the cascades skip.
+struct ChainCoefficients
+{
+    CutCoefficients lowCut {}, highCut {};
+    
+    // The parametric bands for each channel of the pair, left or mid first. A band that doesn't
+    // filter a channel is an identity section there; linked, the two are the same.
+    std::array<ParametricCoefficients, 2> parametric {};
+    
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+    
+    // parametric and highCut are designed for the host rate times this.
+    int oversamplingFactor { 1 };
+    
+    // What the two channels of the pair carry, so the cascades encode and decode to match.
+    StereoMode stereoMode { StereoMode::StereoMode_Linked };
+    
+    // The settings the set was designed from, so the smoother can ramp them. A blend of two sets has none.
+    std::optional<ChainSettings> settings;
+};
+
+ChainCoefficients makeChainCoefficients(const ChainSettings& chainSettings, double sampleRate);
+
+// The designs above for one sample rate, with the same interface as CoefficientTables, so
+// updateChainCoefficients() can design either way.
+struct DirectDesigns
+{
+    double sampleRate { 0.0 };
+    
+    void prepare(double newSampleRate) noexcept { sampleRate = newSampleRate; }
+    double getSampleRate() const noexcept { return sampleRate; }
+    
+    BiquadCoefficients makeBandCoefficients(const BandSettings& band, DesignMethod designMethod) const { return ::makeBandCoefficients(band, designMethod, sampleRate); }
+    CutCoefficients makeLowCutCoefficients(const ChainSettings& chainSettings) const { return ::makeLowCutCoefficients(chainSettings, sampleRate); }
+    CutCoefficients makeHighCutCoefficients(const ChainSettings& chainSettings) const { return ::makeHighCutCoefficients(chainSettings, sampleRate); }
+};
+
+// Redesigns only the bands set in bandsToUpdate and leaves the rest of the set untouched. The low cut is
+// designed by hostRateDesigns, which must already be prepared; oversampledDesigns is prepared here for
+// the host rate times the oversampling factor. Designs is DirectDesigns or CoefficientTables.
+template <typename Designs>
+void updateChainCoefficients(ChainCoefficients& coefficients, const ChainSettings& chainSettings,
+                             Designs& hostRateDesigns, Designs& oversampledDesigns, int bandsToUpdate){
+    // The oversampled bands must always share one rate.
+    if (chainSettings.oversamplingFactor != coefficients.oversamplingFactor){
+        bandsToUpdate |= getBandMask(ChainPossitions::Peak) | getBandMask(ChainPossitions::HighCut);
+        coefficients.oversamplingFactor = chainSettings.oversamplingFactor;
+    }
+    
+    oversampledDesigns.prepare(hostRateDesigns.getSampleRate() * coefficients.oversamplingFactor);
+    
+    if (bandsToUpdate & getBandMask(ChainPossitions::LowCut)){
+        coefficients.lowCut = hostRateDesigns.makeLowCutCoefficients(chainSettings);
+        coefficients.lowCutSlope = chainSettings.lowCutSlope;
+    }
+    if (bandsToUpdate & getBandMask(ChainPossitions::Peak)){
+        // Each band is designed once, whichever channels it goes on.
+        for (size_t i = 0; i < chainSettings.bands.size(); ++i)
+            placeBand(coefficients.parametric, i, oversampledDesigns.makeBandCoefficients(chainSettings.bands[i], chainSettings.designMethod),
+                      chainSettings.bands[i], chainSettings.stereoMode);
+        
+        coefficients.stereoMode = chainSettings.stereoMode;
+    }
+    if (bandsToUpdate & getBandMask(ChainPossitions::HighCut)){
+        coefficients.highCut = oversampledDesigns.makeHighCutCoefficients(chainSettings);
+        coefficients.highCutSlope = chainSettings.highCutSlope;
+    }
+    
+    // The bands that weren't updated were designed from these same settings.
+    coefficients.settings = chainSettings;
+}
+
+// The same, designed directly for sampleRate.
+void updateChainCoefficients(ChainCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate, int bandsToUpdate);
+
+// A set part of the way from one set to another: each coefficient moves by amount (0 to 1) of the difference,
+// which, like the smoother's ramps, keeps every section stable. Groups that can't be blended, because their
+// slope or rate differs, come whole from whichever end is nearer. If the stereo modes differ, the parametric
+// bands and the mode stay as they are in from, so the glide never resets the cascades. The blend has no settings.
+ChainCoefficients interpolateChainCoefficients(const ChainCoefficients& from, const ChainCoefficients& to, double amount);
+
+// How long, in samples at the host rate, the chain's impulse response takes to fall 120 dB. Each active
+// section's decay follows from its pole radius, so steeper slopes and higher Qs ring for longer; the sum
+// over the sections is a safe upper bound for the cascade.
+double getTailLengthSamples(const ChainCoefficients& coefficients);
+
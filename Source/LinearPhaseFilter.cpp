@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilter.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseFilter.h"
+
+LinearPhaseSynthesisThread::LinearPhaseSynthesisThread() : juce::Thread("FirstEQ Linear Phase Synthesis"){
+    startThread();
+}
+
+LinearPhaseSynthesisThread::~LinearPhaseSynthesisThread(){
+    stopThread(1000);
+}
+
+void LinearPhaseSynthesisThread::addFilter(LinearPhaseFilter* filter){
+    const juce::ScopedLock sl(lock);
+    filters.add(filter);
+}
+
+void LinearPhaseSynthesisThread::removeFilter(LinearPhaseFilter* filter){
+    for (;;){
+        {
+            const juce::ScopedLock sl(lock);
+            filters.removeFirstMatchingValue(filter);
+            
+            if (synthesising != filter)
+                break;
+        }
+        
+        synthesisFinished.wait(10);
+    }
+    
+    // The filters after it moved down one, so a pass under way may have skipped one.
+    notify();
+}
+
+void LinearPhaseSynthesisThread::run(){
+    while (! threadShouldExit()){
+        for (int i = 0;; ++i){
+            LinearPhaseFilter* filter;
+            
+            {
+                const juce::ScopedLock sl(lock);
+                filter = synthesising = filters[i];
+            }
+            
+            if (filter == nullptr)
+                break;
+            
+            filter->synthesisePending(false);
+            
+            {
+                const juce::ScopedLock sl(lock);
+                synthesising = nullptr;
+            }
+            
+            synthesisFinished.signal();
+        }
+        
+        wait(-1);
+    }
+}
+
+//==============================================================================
+LinearPhaseFilter::LinearPhaseFilter(){
+    synthesisThread->addFilter(this);
+}
+
+LinearPhaseFilter::~LinearPhaseFilter(){
+    synthesisThread->removeFilter(this);
+}
+
+void LinearPhaseFilter::prepare(const juce::dsp::ProcessSpec& spec){
+    const juce::ScopedLock sl(lock);
+    
+    auto order = juce::jmax(6, static_cast<int>(std::ceil(std::log2(minimumFirLengthSeconds * spec.sampleRate))));
+    
+    if (fft == nullptr || fft->getSize() != (1 << order))
+        fft = std::make_unique<juce::dsp::FFT>(order);
+    
+    firLength = 1 << order;
+    spectrum.assign(static_cast<size_t>(firLength) * 2, 0.f);
+    
+    preparedSpec = spec;
+    
+    auto numPairs = (spec.numChannels + 1) / 2;
+    convolutions.clear();
+    
+    for (juce::uint32 pair = 0; pair < numPairs; ++pair){
+        auto convolution = std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::NonUniform{ headSize }, messageQueue);
+        convolution->prepare(getPairSpec(pair));
+        convolutions.push_back(std::move(convolution));
+    }
+    
+    floatScratch.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+    
+    latencySamples = firLength / 2 + (convolutions.empty() ? 0 : convolutions.front()->getLatency());
+}
+
+juce::dsp::ProcessSpec LinearPhaseFilter::getPairSpec(juce::uint32 pair) const noexcept{
+    return { preparedSpec.sampleRate, preparedSpec.maximumBlockSize, juce::jmin(2u, preparedSpec.numChannels - pair * 2) };
+}
+
+void LinearPhaseFilter::loadPendingImpulseResponse(){
+    // Holding the lock waits out a synthesis the synthesis thread already has under way, so its
+    // impulse response is queued before the convolutions are prepared again, never after.
+    const juce::ScopedLock sl(lock);
+    
+    if (! synthesisePending(true))
+        return;
+    
+    // Convolution::prepare() runs every queued load on this thread and starts on the newest
+    // impulse response straight away, with no crossfade.
+    for (size_t pair = 0; pair < convolutions.size(); ++pair)
+        convolutions[pair]->prepare(getPairSpec(static_cast<juce::uint32>(pair)));
+    
+    loadedStereoMode = queuedStereoMode;
+}
+
+bool LinearPhaseFilter::isWaitingForLoad() const{
+    const juce::ScopedLock sl(pendingLock);
+    return hasPending && pending.coefficients.stereoMode != loadedStereoMode;
+}
+
+void LinearPhaseFilter::reset(){
+    for (auto& convolution : convolutions)
+        convolution->reset();
+}
+
+void LinearPhaseFilter::process(const juce::dsp::AudioBlock<float>& block){
+    for (size_t pair = 0; pair < convolutions.size(); ++pair){
+        auto firstChannel = pair * 2;
+        
+        if (firstChannel >= block.getNumChannels())
+            break;
+        
+        auto channels = block.getSubsetChannelBlock(firstChannel, juce::jmin(static_cast<size_t>(2), block.getNumChannels() - firstChannel));
+        convolutions[pair]->process(juce::dsp::ProcessContextReplacing<float>(channels));
+    }
+}
+
+void LinearPhaseFilter::process(const juce::dsp::AudioBlock<double>& block){
+    auto numChannels = juce::jmin(block.getNumChannels(), static_cast<size_t>(floatScratch.getNumChannels()));
+    
+    for (size_t start = 0, numSamples = block.getNumSamples(); start < numSamples;){
+        auto length = juce::jmin(numSamples - start, static_cast<size_t>(floatScratch.getNumSamples()));
+        juce::dsp::AudioBlock<float> scratch(floatScratch.getArrayOfWritePointers(), numChannels, length);
+        
+        for (size_t channel = 0; channel < numChannels; ++channel){
+            auto* source = block.getChannelPointer(channel) + start;
+            auto* destination = scratch.getChannelPointer(channel);
+            
+            for (size_t i = 0; i < length; ++i)
+                destination[i] = static_cast<float>(source[i]);
+        }
+        
+        process(scratch);
+        
+        for (size_t channel = 0; channel < numChannels; ++channel){
+            auto* source = scratch.getChannelPointer(channel);
+            auto* destination = block.getChannelPointer(channel) + start;
+            
+            for (size_t i = 0; i < length; ++i)
+                destination[i] = static_cast<double>(source[i]);
+        }
+        
+        start += length;
+    }
+}
+
+void LinearPhaseFilter::coefficientsDesigned(const CoefficientSnapshot& snapshot){
+    if (! enabled)
+        return;
+    
+    {
+        const juce::ScopedLock sl(pendingLock);
+        
+        // Sets can arrive from two threads at once; an older one never replaces a newer one.
+        if (snapshot.version <= pending.version)
+            return;
+        
+        pending = snapshot;
+        hasPending = true;
+    }
+    
+    synthesisThread->notify();
+}
+
+bool LinearPhaseFilter::synthesisePending(bool canChangeStereoMode){
+    // Taken before the set is, so that whoever takes it has finished loading it once the lock is free.
+    const juce::ScopedLock sl(lock);
+    CoefficientSnapshot snapshot;
+    
+    {
+        const juce::ScopedLock pendingSl(pendingLock);
+        
+        if (! hasPending)
+            return false;
+        
+        // Left for loadPendingImpulseResponse(); a crossfade would run the old mode's channels through it.
+        if (! canChangeStereoMode && pending.coefficients.stereoMode != loadedStereoMode)
+            return false;
+        
+        snapshot = pending;
+        hasPending = false;
+    }
+    
+    synthesise(snapshot.coefficients, snapshot.sampleRate);
+    return true;
+}
+
+// |H(e^jw)| of one normalised biquad.
+static double getMagnitude(const BiquadCoefficients& c, std::complex<double> z){
+    auto zInv = 1.0 / z;
+    auto numerator = c[0] + (c[1] + c[2] * zInv) * zInv;
+    auto denominator = 1.0 + (c[4] + c[5] * zInv) * zInv;
+    return std::abs(numerator / denominator);
+}
+
+void LinearPhaseFilter::synthesise(const ChainCoefficients& coefficients, double sampleRate){
+    const juce::ScopedLock sl(lock);
+    
+    if (fft == nullptr)
+        return;
+    
+    // Linked, one FIR serves every channel; otherwise each channel of the pair gets its own.
+    auto numFirs = coefficients.stereoMode == StereoMode_Linked ? 1 : 2;
+    juce::AudioBuffer<float> impulseResponse(numFirs, firLength);
+    
+    for (int channel = 0; channel < numFirs; ++channel)
+        synthesise(coefficients, coefficients.parametric[static_cast<size_t>(channel)], impulseResponse.getWritePointer(channel));
+    
+    auto stereo = numFirs == 2 ? juce::dsp::Convolution::Stereo::yes : juce::dsp::Convolution::Stereo::no;
+    
+    for (auto& convolution : convolutions){
+        juce::AudioBuffer<float> copy(impulseResponse);
+        convolution->loadImpulseResponse(std::move(copy), sampleRate, stereo,
+                                         juce::dsp::Convolution::Trim::no, juce::dsp::Convolution::Normalise::no);
+    }
+    
+    queuedStereoMode = coefficients.stereoMode;
+}
+
+void LinearPhaseFilter::synthesise(const ChainCoefficients& coefficients, const ParametricCoefficients& parametric, float* fir){
+    auto numBins = firLength / 2 + 1;
+    
+    // The chain's magnitude response, sampled on the FFT grid as a real, even sequence.
+    for (int bin = 0; bin < numBins; ++bin){
+        auto w = juce::MathConstants<double>::twoPi * bin / firLength;
+        auto z = std::polar(1.0, w);
+        
+        // Bands designed for an oversampled rate are read off at the matching lower frequency,
+        // so the FIR gets their uncramped shape without any oversampling of its own.
+        auto zOversampled = std::polar(1.0, w / coefficients.oversamplingFactor);
+        auto magnitude = 1.0;
+        
+        for (const auto& band : parametric)
+            if (! isIdentity(band))
+                magnitude *= getMagnitude(band, zOversampled);
+        
+        for (int i = 0; i <= coefficients.lowCutSlope; ++i)
+            magnitude *= getMagnitude(coefficients.lowCut[static_cast<size_t>(i)], z);
+        for (int i = 0; i <= coefficients.highCutSlope; ++i)
+            magnitude *= getMagnitude(coefficients.highCut[static_cast<size_t>(i)], zOversampled);
+        
+        spectrum[static_cast<size_t>(bin)] = static_cast<float>(magnitude);
+        
+        if (bin > 0 && bin < firLength / 2)
+            spectrum[static_cast<size_t>(firLength - bin)] = static_cast<float>(magnitude);
+    }
+    
+    // For a real, even sequence the forward and inverse DFTs only differ by the 1/N scale,
+    // so the forward transform gives the zero-phase impulse response without relying on
+    // how the inverse is scaled. Its real parts are h[0..N/2], and h[N-n] = h[n].
+    fft->performRealOnlyForwardTransform(spectrum.data(), true);
+    
+    // Centre the response at N/2 and window it, which makes it causal and linear phase.
+    auto scale = 1.0f / static_cast<float>(firLength);
+    
+    for (int i = 0; i < firLength; ++i){
+        auto n = std::abs(i - firLength / 2);
+        auto phase = juce::MathConstants<double>::twoPi * i / firLength;
+        auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        fir[i] = spectrum[static_cast<size_t>(n) * 2] * scale * static_cast<float>(window);
+    }
+}
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilter.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+#include "CoefficientDesigner.h"
+
+class LinearPhaseFilter;
+
+/**
+    One background thread, shared by every plugin instance in the process, that
+    synthesises the FIRs of any registered LinearPhaseFilter with a new coefficient
+    set waiting. It sleeps until a filter is handed one.
+*/
+class LinearPhaseSynthesisThread : public juce::Thread
+{
+public:
+    LinearPhaseSynthesisThread();
+    ~LinearPhaseSynthesisThread() override;
+    
+    void addFilter(LinearPhaseFilter* filter);
+    
+    /** Waits for a synthesis for this filter that is already under way, if any. */
+    void removeFilter(LinearPhaseFilter* filter);
+    
+    void run() override;
+    
+private:
+    // Guards the list and which filter is being worked on, never the work itself.
+    juce::CriticalSection lock;
+    juce::Array<LinearPhaseFilter*> filters;
+    LinearPhaseFilter* synthesising { nullptr };
+    juce::WaitableEvent synthesisFinished;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinearPhaseSynthesisThread)
+};
+
+/**
+    Linear-phase version of the chain: an FIR with the chain's magnitude
+    response and a constant delay of half its length, run by non-uniformly
+    partitioned FFT convolution.
+
+    Each new coefficient set is only stored as it is designed; the FIR is
+    resynthesised from the newest one on the synthesis thread, so the designer
+    thread never waits on an FFT. juce::dsp::Convolution then swaps it in on its
+    own background thread and crossfades to it. Outside linked mode it's a stereo
+    pair of FIRs, one per channel; the processor does any Mid/Side encoding.
+
+    Only sets for the stereo mode already running go that way, since there is no
+    crossfading between FIRs for channels that mean different things. A set for
+    another mode waits for loadPendingImpulseResponse(), and the processor follows
+    getStereoMode() rather than the mode of the newest set.
+*/
+class LinearPhaseFilter : public CoefficientDesigner::Listener
+{
+public:
+    LinearPhaseFilter();
+    ~LinearPhaseFilter() override;
+    
+    /** Minimum FIR length; the real length is the next power of two, so it scales with the sample rate. */
+    static constexpr double minimumFirLengthSeconds = 0.15;
+    
+    /** Size of the zero-latency head partition; later partitions grow from here. */
+    static constexpr int headSize = 256;
+    
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+    
+    /** Message thread, after prepare() and while the audio thread is stopped: synthesises any set still
+        waiting for the synthesis thread and has the convolutions load it before returning, so the first
+        block processed already runs the right FIR. Without this it would be swapped in a few blocks late.
+        It's also the only way a set for a new stereo mode is loaded.
+    */
+    void loadPendingImpulseResponse();
+    
+    /** True if the set waiting is for another stereo mode, so it needs loadPendingImpulseResponse(). */
+    bool isWaitingForLoad() const;
+    
+    /** The stereo mode the loaded FIR was designed for, which is the one its channels are in. */
+    StereoMode getStereoMode() const noexcept { return loadedStereoMode; }
+    
+    /** While disabled, new designs are ignored, so the FIR costs nothing in minimum-phase mode. */
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled = shouldBeEnabled; }
+    
+    /** Samples of delay added by the filter at the prepared sample rate. */
+    int getLatencySamples() const noexcept { return latencySamples; }
+    
+    /** Samples the output keeps going for after the input stops: the whole FIR, plus the convolution's own delay. */
+    int getTailLengthSamples() const noexcept { return latencySamples + firLength / 2; }
+    
+    void process(const juce::dsp::AudioBlock<float>& block);
+    
+    /** Convolution is float-only, so double blocks go through a float scratch buffer. */
+    void process(const juce::dsp::AudioBlock<double>& block);
+    
+    /** Any thread: keeps the set for the synthesis thread, replacing any set it hasn't got to yet. */
+    void coefficientsDesigned(const CoefficientSnapshot& snapshot) override;
+    
+private:
+    friend class LinearPhaseSynthesisThread;
+    
+    // Returns false if there was no set waiting, or it was for another stereo mode and that isn't allowed.
+    bool synthesisePending(bool canChangeStereoMode);
+    void synthesise(const ChainCoefficients& coefficients, double sampleRate);
+    
+    // One channel's FIR, firLength samples, with the given parametric bands and the chain's cuts.
+    void synthesise(const ChainCoefficients& coefficients, const ParametricCoefficients& parametric, float* fir);
+    
+    // The spec for the convolution that runs one pair of the prepared channels.
+    juce::dsp::ProcessSpec getPairSpec(juce::uint32 pair) const noexcept;
+    
+    juce::CriticalSection lock;
+    std::atomic<bool> enabled { false };
+    
+    // The newest set handed over, and whether it has been synthesised yet.
+    juce::CriticalSection pendingLock;
+    CoefficientSnapshot pending;
+    bool hasPending { false };
+    
+    // The mode of the last FIR handed to the convolutions, and of the one they were last prepared with.
+    StereoMode queuedStereoMode { StereoMode_Linked };
+    std::atomic<StereoMode> loadedStereoMode { StereoMode_Linked };
+    
+    juce::dsp::ProcessSpec preparedSpec { 0.0, 0, 0 };
+    int firLength { 0 }, latencySamples { 0 };
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> spectrum;
+    
+    // Convolution handles at most two channels, so there is one per channel pair,
+    // all loading their impulse responses through one message queue.
+    juce::dsp::ConvolutionMessageQueue messageQueue;
+    std::vector<std::unique_ptr<juce::dsp::Convolution>> convolutions;
+    
+    juce::AudioBuffer<float> floatScratch;
+    
+    juce::SharedResourcePointer<LinearPhaseSynthesisThread> synthesisThread;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinearPhaseFilter)
+};
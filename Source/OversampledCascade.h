@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    OversampledCascade.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "PolyphaseOversampler.h"
+
+/**
+    The chain for one group of channels, with the bands that cramp near
+    Nyquist optionally oversampled.
+
+    The low cut always runs at the host rate. When the coefficients were designed
+    for 2x or 4x, the parametric and high cut sections run at that rate between a
+    polyphase upsampler and downsampler, so only they pay for the extra samples.
+    At 1x everything runs in one cascade, exactly as without oversampling.
+*/
+template <typename SampleType>
+class OversampledCascade
+{
+public:
+    /** Message thread: sizes the oversampled scratch for blocks of up to maxBlockSize samples. */
+    void prepare(size_t maxBlockSize)
+    {
+        // AudioBlock aligns its channels for SIMDRegister, which a plain HeapBlock<SampleType> wouldn't.
+        oversampledBlock = juce::dsp::AudioBlock<SampleType>(oversampledData, 1, maxBlockSize * PolyphaseOversampler<SampleType>::maxFactor);
+        oversampledBlock.clear();
+    }
+    
+    /** Takes the oversampling factor from the set as well. Changing it starts the oversampled part from silence. */
+    void setCoefficients(const ChainCoefficients& coefficients) noexcept
+    {
+        if (coefficients.oversamplingFactor != oversampler.getFactor()){
+            oversampler.setFactor(coefficients.oversamplingFactor);
+            oversampled.reset();
+        }
+        
+        if (oversampler.getFactor() > 1){
+            const auto oversampledBands = getBandMask(ChainPossitions::Peak) | getBandMask(ChainPossitions::HighCut);
+            hostRate.setCoefficients(coefficients, getBandMask(ChainPossitions::LowCut));
+            oversampled.setCoefficients(coefficients, oversampledBands);
+        }
+        else{
+            hostRate.setCoefficients(coefficients);
+            oversampled.setCoefficients(coefficients, 0);
+        }
+    }
+    
+    /** True when processing would leave the samples untouched. While oversampling, the resamplers
+        still run (and delay the signal) even if every section is neutral, so this is only ever true at 1x.
+    */
+    bool isIdentity() const noexcept
+    {
+        return oversampler.getFactor() == 1 && hostRate.isIdentity() && oversampled.isIdentity();
+    }
+    
+    /** The largest filter state (see BiquadCascade::getStateMagnitude), the resamplers' allpasses included.
+        Their slowest section (a coefficient near 0.95) takes about 350 samples to fall to -160 dB, longer
+        than many of the sections, so a tail can still be coming out of them after the cascade has gone quiet.
+    */
+    double getStateMagnitude() const noexcept
+    {
+        return juce::jmax(hostRate.getStateMagnitude(), oversampled.getStateMagnitude(), oversampler.getStateMagnitude());
+    }
+    
+    void reset() noexcept
+    {
+        hostRate.reset();
+        oversampled.reset();
+        oversampler.reset();
+    }
+    
+    /** numSamples must be no more than the block size given to prepare(). */
+    void process(SampleType* samples, size_t numSamples) noexcept
+    {
+        hostRate.process(samples, numSamples);
+        
+        if (auto factor = static_cast<size_t>(oversampler.getFactor()); factor > 1){
+            auto* upsampled = oversampledBlock.getChannelPointer(0);
+            
+            oversampler.processUp(samples, upsampled, numSamples);
+            oversampled.process(upsampled, numSamples * factor);
+            oversampler.processDown(upsampled, samples, numSamples);
+        }
+    }
+    
+private:
+    BiquadCascade<SampleType> hostRate, oversampled;
+    PolyphaseOversampler<SampleType> oversampler;
+    juce::HeapBlock<char> oversampledData;
+    juce::dsp::AudioBlock<SampleType> oversampledBlock;
+};
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+// Every FirstEQ parameter is ranged, so each has a value in its own units and a way to convert it.
+static juce::RangedAudioParameter* asRanged(juce::AudioProcessorParameter* parameter){
+    return dynamic_cast<juce::RangedAudioParameter*>(parameter);
+}
+
+ParameterSnapshot::ParameterSnapshot(juce::AudioProcessorValueTreeState& apvts, const juce::StringArray& excludedIDs){
+    const auto& parameters = apvts.processor.getParameters();
+    values.reserve(static_cast<size_t>(parameters.size()));
+
+    for (auto* parameter : parameters)
+        if (auto* ranged = asRanged(parameter); ranged != nullptr && ! excludedIDs.contains(ranged->getParameterID()))
+            values.push_back({ ranged->getParameterID(), ranged->convertFrom0to1(ranged->getValue()) });
+}
+
+const ParameterSnapshot::Value* ParameterSnapshot::find(const juce::RangedAudioParameter& parameter, int index) const noexcept{
+    auto parameterID = parameter.getParameterID();
+
+    // Written by this version, every value is where its parameter is.
+    if (juce::isPositiveAndBelow(index, static_cast<int>(values.size())) && values[static_cast<size_t>(index)].parameterID == parameterID)
+        return &values[static_cast<size_t>(index)];
+
+    for (const auto& value : values)
+        if (value.parameterID == parameterID)
+            return &value;
+
+    return nullptr;
+}
+
+float ParameterSnapshot::getValue(const juce::RangedAudioParameter& parameter, int index) const{
+    if (const auto* value = find(parameter, index))
+        return value->value;
+
+    return parameter.convertFrom0to1(parameter.getDefaultValue());
+}
+
+void ParameterSnapshot::apply(juce::AudioProcessorValueTreeState& apvts) const{
+    const auto& parameters = apvts.processor.getParameters();
+
+    for (int i = 0; i < parameters.size(); ++i){
+        auto* ranged = asRanged(parameters[i]);
+
+        if (ranged == nullptr)
+            continue;
+
+        if (const auto* value = find(*ranged, i)){
+            auto normalised = ranged->convertTo0to1(value->value);
+
+            if (normalised != ranged->getValue())
+                ranged->setValueNotifyingHost(normalised);
+        }
+    }
+}
+
+void ParameterSnapshot::write(juce::OutputStream& stream) const{
+    stream.writeInt(magic);
+    stream.writeInt(version);
+    stream.writeInt(static_cast<int>(values.size()));
+
+    for (const auto& value : values){
+        stream.writeString(value.parameterID);
+        stream.writeFloat(value.value);
+    }
+}
+
+bool ParameterSnapshot::read(juce::InputStream& stream){
+    values.clear();
+
+    if (stream.readInt() != magic || stream.readInt() != version)
+        return false;
+
+    auto numValues = stream.readInt();
+
+    // Each value is at least five bytes (an empty ID's terminator and the float), so a count the
+    // stream can't hold means it isn't a snapshot after all.
+    if (numValues < 0 || stream.getNumBytesRemaining() < static_cast<juce::int64>(numValues) * 5)
+        return false;
+
+    values.resize(static_cast<size_t>(numValues));
+
+    for (auto& value : values){
+        value.parameterID = stream.readString();
+        value.value = stream.readFloat();
+    }
+
+    return true;
+}
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PerformanceMonitor.h"
+
+void TimingHistogram::record(juce::int64 ticks, double budgetSeconds) noexcept{
+    if (resetPending.load(std::memory_order_relaxed)){
+        resetPending.store(false, std::memory_order_relaxed);
+        clear();
+    }
+
+    auto percent = budgetSeconds > 0.0 ? 100.0 * static_cast<double>(ticks) / (budgetSeconds * ticksPerSecond) : 0.0;
+
+    increment(count);
+    totalTicks.store(totalTicks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+    totalPercent.store(totalPercent.load(std::memory_order_relaxed) + percent, std::memory_order_relaxed);
+
+    if (ticks > worstTicks.load(std::memory_order_relaxed))
+        worstTicks.store(ticks, std::memory_order_relaxed);
+    if (percent > worstPercent.load(std::memory_order_relaxed))
+        worstPercent.store(percent, std::memory_order_relaxed);
+
+    if (percent >= nearMissPercent)
+        increment(nearMisses);
+    if (percent >= 100.0)
+        increment(overruns);
+
+    auto bucket = juce::jlimit(0, numBuckets - 1, static_cast<int>(percent / bucketWidthPercent));
+    increment(buckets[static_cast<size_t>(bucket)]);
+}
+
+void TimingHistogram::clear() noexcept{
+    count.store(0, std::memory_order_relaxed);
+    nearMisses.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+    totalTicks.store(0, std::memory_order_relaxed);
+    worstTicks.store(0, std::memory_order_relaxed);
+    totalPercent.store(0.0, std::memory_order_relaxed);
+    worstPercent.store(0.0, std::memory_order_relaxed);
+
+    for (auto& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+TimingHistogram::Summary TimingHistogram::getSummary() const noexcept{
+    Summary summary;
+
+    // Until the writer gets round to it, a reset reads as already done.
+    if (resetPending.load(std::memory_order_relaxed))
+        return summary;
+
+    summary.count = count.load(std::memory_order_relaxed);
+    summary.nearMisses = nearMisses.load(std::memory_order_relaxed);
+    summary.overruns = overruns.load(std::memory_order_relaxed);
+    summary.worstSeconds = juce::Time::highResolutionTicksToSeconds(worstTicks.load(std::memory_order_relaxed));
+    summary.worstPercent = worstPercent.load(std::memory_order_relaxed);
+
+    if (summary.count > 0){
+        auto n = static_cast<double>(summary.count);
+        summary.meanSeconds = juce::Time::highResolutionTicksToSeconds(totalTicks.load(std::memory_order_relaxed)) / n;
+        summary.meanPercent = totalPercent.load(std::memory_order_relaxed) / n;
+    }
+
+    for (size_t i = 0; i < buckets.size(); ++i)
+        summary.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+
+    return summary;
+}
+
+//==============================================================================
+void PerformanceMonitor::reset() noexcept{
+    processBlock.reset();
+    updateFilters.reset();
+    design.reset();
+}
+
+static juce::String formatSummary(const juce::String& name, const TimingHistogram::Summary& s, bool withBuckets){
+    auto microseconds = [](double seconds){ return juce::String(seconds * 1.0e6, 1) + " us"; };
+    auto percent = [](double value){ return juce::String(value, 1) + "%"; };
+
+    juce::String text;
+    text << name << ": " << juce::String(s.count) << " calls, mean "
+         << microseconds(s.meanSeconds) << " (" << percent(s.meanPercent) << " of budget), worst "
+         << microseconds(s.worstSeconds) << " (" << percent(s.worstPercent) << "), "
+         << juce::String(s.nearMisses) << " over " << percent(TimingHistogram::nearMissPercent) << ", "
+         << juce::String(s.overruns) << " over budget\n";
+
+    if (withBuckets){
+        for (int i = 0; i < TimingHistogram::numBuckets; ++i){
+            auto low = i * TimingHistogram::bucketWidthPercent;
+            auto range = i == TimingHistogram::numBuckets - 1 ? percent(low) + "+"
+                                                              : percent(low) + " - " + percent(low + TimingHistogram::bucketWidthPercent);
+
+            text << "    " << range.paddedRight(' ', 16) << juce::String(s.buckets[static_cast<size_t>(i)]) << "\n";
+        }
+    }
+
+    return text;
+}
+
+juce::String PerformanceMonitor::getReport(bool withBuckets) const{
+    return formatSummary("processBlock", processBlock.getSummary(), withBuckets)
+         + formatSummary("updateFilters", updateFilters.getSummary(), withBuckets)
+         + formatSummary("design", design.getSummary(), withBuckets);
+}
+
+bool PerformanceMonitor::writeReport(const juce::File& file) const{
+    juce::String text;
+    text << "FirstEQ timing report, " << juce::Time::getCurrentTime().toString(true, true) << "\n"
+         << "Budgets: processBlock, the block's length; updateFilters, one control interval; design, a millisecond.\n\n"
+         << getReport(true);
+
+    return file.replaceWithText(text);
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    How long one code path takes, as a share of the time it has.
+
+    One thread records (the audio thread, say) and any thread reads. Recording is
+    wait-free and never takes a lock: with a single writer every counter is a plain
+    relaxed load and store, with no read-modify-write. A reader may see a count from
+    one call and a worst case from the next, which is close enough for a display or
+    a report.
+*/
+class TimingHistogram
+{
+public:
+    /** Each bucket covers 10% of the budget; the last one takes everything from 150% up. */
+    static constexpr int numBuckets = 16;
+    static constexpr double bucketWidthPercent = 10.0;
+
+    /** A call that uses more than this much of its budget leaves the host little room to spare. */
+    static constexpr double nearMissPercent = 50.0;
+
+    /** Writer thread, wait-free: one call that took this many high-resolution ticks, out of budgetSeconds. */
+    void record(juce::int64 ticks, double budgetSeconds) noexcept;
+
+    /** Any thread: clears everything. The writer does it at the start of its next record(). */
+    void reset() noexcept { resetPending.store(true, std::memory_order_relaxed); }
+
+    struct Summary
+    {
+        juce::uint64 count { 0 }, nearMisses { 0 }, overruns { 0 };
+        double meanSeconds { 0 }, worstSeconds { 0 };
+        double meanPercent { 0 }, worstPercent { 0 };
+        std::array<juce::uint64, numBuckets> buckets {};
+    };
+
+    /** Any thread, wait-free. */
+    Summary getSummary() const noexcept;
+
+private:
+    void clear() noexcept;
+
+    template <typename Type>
+    static void increment(std::atomic<Type>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<juce::uint64> count { 0 }, nearMisses { 0 }, overruns { 0 };
+    std::atomic<juce::int64> totalTicks { 0 }, worstTicks { 0 };
+    std::atomic<double> totalPercent { 0 }, worstPercent { 0 };
+    std::array<std::atomic<juce::uint64>, numBuckets> buckets {};
+    std::atomic<bool> resetPending { false };
+
+    const double ticksPerSecond { static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) };
+
+    static_assert(std::atomic<double>::is_always_lock_free && std::atomic<juce::uint64>::is_always_lock_free,
+                  "recording must never fall back on a lock");
+};
+
+/**
+    Always-on timing for one processor instance: processBlock, the coefficient
+    updates the audio thread makes while it ramps, and the designs on the designer
+    thread. Each is measured with two high-resolution tick reads and recorded into
+    its own TimingHistogram.
+*/
+class PerformanceMonitor
+{
+public:
+    TimingHistogram processBlock, updateFilters, design;
+
+    /** Times the enclosing scope into a histogram. */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(TimingHistogram& h, double budget) noexcept
+            : histogram(h), budgetSeconds(budget), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedTimer() { histogram.record(juce::Time::getHighResolutionTicks() - start, budgetSeconds); }
+
+    private:
+        TimingHistogram& histogram;
+        double budgetSeconds;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+    void reset() noexcept;
+
+    /** Message thread: a plain-text summary of every histogram. With withBuckets, the full histograms too. */
+    juce::String getReport(bool withBuckets) const;
+
+    /** Message thread: writes the full report to the file, replacing it. Returns false if it couldn't be written. */
+    bool writeReport(const juce::File& file) const;
+};
@@ -150,45 +150,87 @@ juce::String RotarySliderWithLabels::getDisplayString() const
  }
 
 ResponseCurveComponent::ResponseCurveComponent(FirstEQAudioProcessor& p) : audioProcessor(p){
-    const auto& params = audioProcessor.getParameters();
+    audioProcessor.getPreEQAnalyzer().setActive(true);
+    audioProcessor.getPostEQAnalyzer().setActive(true);
     
-    for(auto param : params){
-        param->addListener(this);
-    }
     startTimerHz(60);
 }
 
 ResponseCurveComponent::~ResponseCurveComponent(){
-    const auto& params = audioProcessor.getParameters();
+    audioProcessor.getPreEQAnalyzer().setActive(false);
+    audioProcessor.getPostEQAnalyzer().setActive(false);
+}
+
+void ResponseCurveComponent::timerCallback(){
+    // Both are pulled every time, so neither falls a frame behind the other.
+    auto preChanged = audioProcessor.getPreEQAnalyzer().pullPath();
+    auto postChanged = audioProcessor.getPostEQAnalyzer().pullPath();
     
-    for(auto param : params){
-        param->removeListener(this);
-    }
+    if (preChanged || postChanged)
+        repaint();
+    
+    if (audioProcessor.getCoefficientSnapshot().version != lastVersion)
+        updateResponseCurve();
 }
 
-void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float newValue){
-    parametersChanged.set(true);
+void ResponseCurveComponent::updateResponseCurve(){
+    const auto& snapshot = audioProcessor.getCoefficientSnapshot();
+    lastVersion = snapshot.version;
+    
+    auto showSecond = snapshot.coefficients.stereoMode != StereoMode_Linked;
+    auto changed = showSecond != showsSecondChannel;
+    showsSecondChannel = showSecond;
+    
+    // Nothing is published until the processor has been prepared, so until then the curve stays flat.
+    changed |= responseCurves[0].setCoefficients(snapshot.coefficients, snapshot.sampleRate, 0);
+    
+    if (showsSecondChannel)
+        changed |= responseCurves[1].setCoefficients(snapshot.coefficients, snapshot.sampleRate, 1);
+    
+    if (changed){
+        updatePath();
+        repaint();
+    }
 }
 
-void ResponseCurveComponent::timerCallback(){
-    if (parametersChanged.compareAndSetBool(false, true)){
-        //update monochain
-        auto chainSettings = getChainSettings(audioProcessor.apvts);
-        auto peakCoefficients = makePeakFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPossitions::Peak>().coefficients, peakCoefficients);
-         
-        auto lowCutCoefficients = makeLowCutFilter(chainSettings, audioProcessor.getSampleRate());
-        auto highCutCoefficients = makeHighCutFilter(chainSettings, audioProcessor.getSampleRate());
+void ResponseCurveComponent::updatePath(){
+    using namespace juce;
+    
+    auto responseArea = getLocalBounds();
+    
+    const float outputMin = responseArea.getBottom();
+    const float outputMax = responseArea.getY();
+    auto map = [outputMin, outputMax](float input){
+        return jmap(input, -24.f, 24.f, outputMin, outputMax);
+    };
+    
+    for (size_t channel = 0; channel < responseCurves.size(); ++channel){
+        const auto& decibels = responseCurves[channel].getDecibels();
+        auto& path = responseCurvePaths[channel];
         
-        updateCutFilter(monoChain.get<ChainPossitions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
-        updateCutFilter(monoChain.get<ChainPossitions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
-
+        path.clear();
         
-        //signal repaint
-        repaint();
+        if (decibels.empty() || (channel == 1 && ! showsSecondChannel))
+            continue;
+        
+        path.preallocateSpace(static_cast<int>(decibels.size()) * 3);
+        path.startNewSubPath(responseArea.getX(), map(decibels.front()));
+        
+        for(size_t i=1; i<decibels.size(); i++)
+            path.lineTo(responseArea.getX()+i, map(decibels[i]));
     }
 }
 
+void ResponseCurveComponent::resized(){
+    for (auto& responseCurve : responseCurves)
+        responseCurve.setNumPoints(getWidth());
+    
+    updateResponseCurve();
+    
+    // The curve itself may not have changed, but where it is drawn has.
+    updatePath();
+}
+
 void ResponseCurveComponent::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
@@ -199,83 +241,248 @@ void ResponseCurveComponent::paint (juce::Graphics& g)
     
     auto responseArea = getLocalBounds();
     
-    auto w = responseArea.getWidth();
+    // The analyzers' paths are in a unit square, and are stretched over the whole area here.
+    auto spectrumTransform = AffineTransform::scale(responseArea.getWidth(), responseArea.getHeight())
+                                             .translated(responseArea.getX(), responseArea.getY());
+    
+    g.setColour(Colours::grey.withAlpha(0.3f));
+    g.fillPath(audioProcessor.getPreEQAnalyzer().getPath(), spectrumTransform);
     
-    auto &lowcut = monoChain.get<ChainPossitions::LowCut>();
-    auto &peak = monoChain.get<ChainPossitions::Peak>();
-    auto &highcut = monoChain.get<ChainPossitions::HighCut>();
+    g.setColour(Colour(97u, 18u, 167u).withAlpha(0.6f));
+    g.fillPath(audioProcessor.getPostEQAnalyzer().getPath(), spectrumTransform);
     
-    auto sampleRate = audioProcessor.getSampleRate();
+    g.setColour(Colours::orange);
+    g.drawRoundedRectangle(responseArea.toFloat(), 20.f, 1.f);
     
-    std::vector<double> mags;
+    // The first channel (left or mid) in white, the second (right or side) in orange under it.
+    g.setColour(Colour(255u, 154u, 1u));
+    g.strokePath(responseCurvePaths[1], PathStrokeType(2.f));
     
-    mags.resize(w);
+    g.setColour(Colours::white);
+    g.strokePath(responseCurvePaths[0], PathStrokeType(2.f));
     
-    for(int i=0; i<w; i++){
-        double mag = 1.f;
-        auto freq = mapToLog10((double)i / (double)w, 20.0, 20000.0);
-        
-        if(!monoChain.isBypassed<ChainPossitions::Peak>())
-            mag *= peak.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!lowcut.isBypassed<0>())
-            mag *= lowcut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!lowcut.isBypassed<1>())
-            mag *= lowcut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!lowcut.isBypassed<2>())
-            mag *= lowcut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!lowcut.isBypassed<3>())
-            mag *= lowcut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!highcut.isBypassed<0>())
-            mag *= highcut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highcut.isBypassed<1>())
-            mag *= highcut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highcut.isBypassed<2>())
-            mag *= highcut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highcut.isBypassed<3>())
-            mag *= highcut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        mags[i]=Decibels::gainToDecibels(mag);
+}
+
+PerformanceOverlay::PerformanceOverlay(FirstEQAudioProcessor& p) : audioProcessor(p){
+    saveButton.onClick = [this]{ saveReport(); };
+    resetButton.onClick = [this]{
+        audioProcessor.getPerformanceMonitor().reset();
+        status.clear();
+        timerCallback();
+    };
+    
+    addAndMakeVisible(saveButton);
+    addAndMakeVisible(resetButton);
+}
+
+void PerformanceOverlay::visibilityChanged(){
+    // Nothing is read while the overlay is hidden; the processor keeps recording either way.
+    if (isVisible()){
+        timerCallback();
+        startTimerHz(4);
+    }
+    else{
+        stopTimer();
     }
+}
+
+void PerformanceOverlay::timerCallback(){
+    report = audioProcessor.getPerformanceMonitor().getReport(false);
+    repaint();
+}
+
+void PerformanceOverlay::saveReport(){
+    auto folder = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("FirstEQ");
+    auto file = folder.getNonexistentChildFile("Timing Report", ".txt");
+    
+    if (folder.createDirectory() && audioProcessor.getPerformanceMonitor().writeReport(file))
+        status = "Saved to " + file.getFullPathName();
+    else
+        status = "Couldn't write " + file.getFullPathName();
+    
+    repaint();
+}
+
+void PerformanceOverlay::paint(juce::Graphics& g){
+    using namespace juce;
+    
+    g.fillAll(Colours::black.withAlpha(0.8f));
     
-    Path responseCurve;
+    auto bounds = getLocalBounds().reduced(8);
+    bounds.removeFromBottom(24);
     
-    const double outputMin = responseArea.getBottom();
-    const double outputMax = responseArea.getY();
-    auto map = [outputMin, outputMax](double input){
-        return jmap(input, -24.0, 24.0, outputMin, outputMax);
+    g.setColour(Colours::white);
+    g.setFont(12.f);
+    g.drawFittedText(report + "\n" + status, bounds, Justification::topLeft, 8);
+}
+
+void PerformanceOverlay::resized(){
+    auto buttons = getLocalBounds().reduced(8).removeFromBottom(20);
+    
+    saveButton.setBounds(buttons.removeFromRight(100));
+    buttons.removeFromRight(8);
+    resetButton.setBounds(buttons.removeFromRight(60));
+}
+
+SnapshotBar::SnapshotBar(FirstEQAudioProcessor& p) : audioProcessor(p){
+    for (int slot = 0; slot < SnapshotBank::numSlots; ++slot){
+        auto& button = slotButtons[static_cast<size_t>(slot)];
+        button.setButtonText(juce::String::charToString(static_cast<juce::juce_wchar>('A' + slot)));
+        button.onClick = [this, slot]{ slotClicked(slot); };
+        addAndMakeVisible(button);
+    }
+    
+    storeButton.setClickingTogglesState(true);
+    addAndMakeVisible(storeButton);
+    
+    updateButtons();
+}
+
+void SnapshotBar::slotClicked(int slot){
+    auto& bank = audioProcessor.getSnapshotBank();
+    
+    if (storeButton.getToggleState()){
+        bank.store(slot);
+        storeButton.setToggleState(false, juce::dontSendNotification);
+    }
+    else{
+        bank.recall(slot);
+    }
+    
+    updateButtons();
+}
+
+void SnapshotBar::updateButtons(){
+    for (int slot = 0; slot < SnapshotBank::numSlots; ++slot)
+        slotButtons[static_cast<size_t>(slot)].setToggleState(audioProcessor.getSnapshotBank().isStored(slot), juce::dontSendNotification);
+}
+
+void SnapshotBar::resized(){
+    auto bounds = getLocalBounds();
+    
+    storeButton.setBounds(bounds.removeFromLeft(50));
+    bounds.removeFromLeft(4);
+    
+    for (auto& button : slotButtons)
+        button.setBounds(bounds.removeFromLeft(24));
+}
+
+// A menu holding a choice parameter's choices, with item IDs from 1 as ComboBoxAttachment expects.
+static void fillChoices(juce::ComboBox& box, juce::RangedAudioParameter* parameter){
+    box.clear(juce::dontSendNotification);
+    
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(parameter))
+        box.addItemList(choice->choices, 1);
+}
+
+BandEditor::BandEditor(FirstEQAudioProcessor& p) : audioProcessor(p),
+    freqSlider(*p.apvts.getParameter(getBandParameterID(0, "Freq")), "Hz"),
+    gainSlider(*p.apvts.getParameter(getBandParameterID(0, "Gain")), "dB"),
+    qualitySlider(*p.apvts.getParameter(getBandParameterID(0, "Quality")), "")
+{
+    for (int band = 0; band < maxParametricBands; ++band)
+        bandSelector.addItem("Band " + juce::String(band + 1), band + 1);
+    
+    bandSelector.onChange = [this]{ selectBand(bandSelector.getSelectedId() - 1); };
+    
+    // Every band has the same choices, so the menus are filled once.
+    fillChoices(typeBox, audioProcessor.apvts.getParameter(getBandParameterID(0, "Type")));
+    fillChoices(channelBox, audioProcessor.apvts.getParameter(getBandParameterID(0, "Channel")));
+    
+    for (auto* comp : std::initializer_list<juce::Component*> { &bandSelector, &typeBox, &channelBox, &freqSlider, &gainSlider, &qualitySlider })
+        addAndMakeVisible(comp);
+    
+    bandSelector.setSelectedId(1, juce::dontSendNotification);
+    selectBand(0);
+}
+
+void BandEditor::selectBand(int band){
+    if (band < 0)
+        return;
+    
+    auto& apvts = audioProcessor.apvts;
+    
+    auto attachSlider = [&apvts, band](std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>& attachment,
+                                       RotarySliderWithLabels& slider, const juce::String& name){
+        auto parameterID = getBandParameterID(band, name);
+        
+        attachment.reset();
+        slider.setParameter(*apvts.getParameter(parameterID));
+        attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, parameterID, slider);
     };
     
-    responseCurve.startNewSubPath(responseArea.getX(), map(mags.front()));
+    auto attachBox = [&apvts, band](std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>& attachment,
+                                    juce::ComboBox& box, const juce::String& name){
+        attachment.reset();
+        attachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, getBandParameterID(band, name), box);
+    };
+    
+    attachSlider(freqAttachment, freqSlider, "Freq");
+    attachSlider(gainAttachment, gainSlider, "Gain");
+    attachSlider(qualityAttachment, qualitySlider, "Quality");
+    attachBox(typeAttachment, typeBox, "Type");
+    attachBox(channelAttachment, channelBox, "Channel");
+}
+
+void BandEditor::resized(){
+    auto bounds = getLocalBounds();
     
-    for(size_t i=1; i<mags.size(); i++)
-    responseCurve.lineTo(responseArea.getX()+i, map(mags[i]));
+    bandSelector.setBounds(bounds.removeFromTop(24).reduced(4, 2));
     
-    g.setColour(Colours::orange);
-    g.drawRoundedRectangle(responseArea.toFloat(), 20.f, 1.f);
+    auto menus = bounds.removeFromTop(24).reduced(4, 2);
+    typeBox.setBounds(menus.removeFromLeft(menus.getWidth() / 2).withTrimmedRight(2));
+    channelBox.setBounds(menus.withTrimmedLeft(2));
     
-    g.setColour(Colours::white);
-    g.strokePath(responseCurve, PathStrokeType(2.f));
+    freqSlider.setBounds(bounds.removeFromTop(bounds.getHeight() / 3));
+    gainSlider.setBounds(bounds.removeFromTop(bounds.getHeight() / 2));
+    qualitySlider.setBounds(bounds);
+}
+
+// The chain-wide choices, in the order the bar shows them.
+static const std::array<const char*, 6> chainOptionIDs { "Stereo Mode", "Phase Mode", "Oversampling", "Filter Design", "Filter Precision", "Morph Target" };
+
+ChainOptionsBar::ChainOptionsBar(FirstEQAudioProcessor& p) :
+    morphAttachment(p.apvts, "Morph", morphSlider)
+{
+    static_assert(chainOptionIDs.size() == numOptions, "one menu per option");
+    
+    for (size_t i = 0; i < optionBoxes.size(); ++i){
+        auto& box = optionBoxes[i];
+        
+        fillChoices(box, p.apvts.getParameter(chainOptionIDs[i]));
+        box.setTooltip(chainOptionIDs[i]);
+        optionAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(p.apvts, chainOptionIDs[i], box);
+        addAndMakeVisible(box);
+    }
+    
+    morphSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 50, 20);
+    addAndMakeVisible(morphSlider);
+}
+
+void ChainOptionsBar::resized(){
+    auto bounds = getLocalBounds();
+    
+    morphSlider.setBounds(bounds.removeFromRight(bounds.getWidth() / 4));
+    
+    auto width = bounds.getWidth() / numOptions;
     
+    for (auto& box : optionBoxes)
+        box.setBounds(bounds.removeFromLeft(width).reduced(2, 0));
 }
 
 //==============================================================================
 FirstEQAudioProcessorEditor::FirstEQAudioProcessorEditor (FirstEQAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p),
-peakFreqSlider(*audioProcessor.apvts.getParameter("Peak Freq"), "Hz"),
-peakGainSlider(*audioProcessor.apvts.getParameter("Peak Gain"), "dB"),
-peakQualitySlider(*audioProcessor.apvts.getParameter("Peak Quality"), ""),
 lowCutFreqSlider(*audioProcessor.apvts.getParameter("LowCut Freq"), "Hz"),
 highCutFreqSlider(*audioProcessor.apvts.getParameter("HighCut Freq"), "Hz"),
 lowCutSlopeSlider(*audioProcessor.apvts.getParameter("LowCut Slope"), "dB/Oct"),
 highCutSlopeSlider(*audioProcessor.apvts.getParameter("HighCut Slope"), "dB/Oct"),
-
+bandEditor(audioProcessor),
+chainOptionsBar(audioProcessor),
 
 responseCurveComponent(audioProcessor),
-peakFreqSliderAttachment(audioProcessor.apvts, "Peak Freq", peakFreqSlider),
-peakGainSliderAttachment(audioProcessor.apvts, "Peak Gain", peakGainSlider),
-peakQualitySliderAttachment(audioProcessor.apvts, "Peak Quality", peakQualitySlider),
+performanceOverlay(audioProcessor),
+snapshotBar(audioProcessor),
 lowCutFreqSliderAttachment(audioProcessor.apvts, "LowCut Freq", lowCutFreqSlider),
 highCutFreqSliderAttachment(audioProcessor.apvts, "HighCut Freq", highCutFreqSlider),
 lowCutSlopeSliderAttachment(audioProcessor.apvts, "LowCut Slope", lowCutSlopeSlider),
@@ -288,7 +495,13 @@ highCutSlopeSliderAttachment(audioProcessor.apvts, "HighCut Slope", highCutSlope
         addAndMakeVisible(comp);
     }
     
-    setSize (600, 400);
+    // Shown over the response curve on demand; the button stays on top of it.
+    addChildComponent(performanceOverlay);
+    timingButton.setClickingTogglesState(true);
+    timingButton.onClick = [this]{ performanceOverlay.setVisible(timingButton.getToggleState()); };
+    timingButton.toFront(false);
+    
+    setSize (600, 480);
 }
 
 FirstEQAudioProcessorEditor::~FirstEQAudioProcessorEditor()
@@ -314,10 +527,15 @@ void FirstEQAudioProcessorEditor::resized()
     auto responseArea = bounds.removeFromTop(bounds.getHeight()*0.33);
     
     responseCurveComponent.setBounds(responseArea);
+    performanceOverlay.setBounds(responseArea);
+    timingButton.setBounds(responseArea.getRight() - 70, responseArea.getY() + 6, 60, 20);
+    snapshotBar.setBounds(responseArea.getX() + 10, responseArea.getY() + 6, 150, 20);
+    
+    chainOptionsBar.setBounds(bounds.removeFromBottom(28).reduced(6, 2));
     
     auto lowCutArea = bounds.removeFromLeft(bounds.getWidth()*0.33);
     auto highCutArea = bounds.removeFromRight(bounds.getWidth()*0.5);
-    auto eqArea = bounds;
+    auto bandArea = bounds;
     
     lowCutFreqSlider.setBounds(lowCutArea.removeFromTop(lowCutArea.getHeight()*0.5));
     lowCutSlopeSlider.setBounds(lowCutArea);
@@ -328,15 +546,13 @@ void FirstEQAudioProcessorEditor::resized()
     
     
     
-    peakFreqSlider.setBounds(eqArea.removeFromTop(eqArea.getHeight()*0.33));
-    peakGainSlider.setBounds(eqArea.removeFromTop(eqArea.getHeight()*0.5));
-    peakQualitySlider.setBounds(eqArea);
+    bandEditor.setBounds(bandArea);
 
 }
 
 std::vector<juce::Component*> FirstEQAudioProcessorEditor::getComps()
 {
     return {
-        &peakFreqSlider, &peakGainSlider, &peakQualitySlider, &lowCutFreqSlider, &highCutFreqSlider, &lowCutSlopeSlider, &highCutSlopeSlider, &responseCurveComponent
+        &lowCutFreqSlider, &highCutFreqSlider, &lowCutSlopeSlider, &highCutSlopeSlider, &bandEditor, &chainOptionsBar, &responseCurveComponent, &timingButton, &snapshotBar
     };
 }
@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ResponseCurve.h"
 
 struct LookAndFeel : juce::LookAndFeel_V4{
     void drawRotarySlider (juce::Graphics&, int x, int y, int width, int height,
@@ -28,6 +29,12 @@ struct RotarySliderWithLabels : juce::Slider{
         setLookAndFeel(nullptr);
     }
     
+    // For a knob that is re-attached to another parameter, so its label follows.
+    void setParameter(juce::RangedAudioParameter& rap){
+        param = &rap;
+        repaint();
+    }
+    
     void paint(juce::Graphics& g) override;
     juce::Rectangle<int> getSliderBounds() const;
     int getTextHeight() const { return 14; }
@@ -40,23 +47,104 @@ private:
     LookAndFeel lnf;
 };
 
-struct ResponseCurveComponent: juce::Component, juce::AudioProcessorParameter::Listener, juce::Timer{
+struct ResponseCurveComponent: juce::Component, juce::Timer{
     ResponseCurveComponent(FirstEQAudioProcessor&);
     ~ResponseCurveComponent();
+   
+    void timerCallback() override;
+    
+    void paint(juce::Graphics &g) override;
+    void resized() override;
     
-    void parameterValueChanged (int parameterIndex, float newValue) override;
+private:
+    FirstEQAudioProcessor& audioProcessor;
+    
+    // The processor's designer publishes every set it designs; this polls for a new version
+    // instead of listening to the parameters, so nothing runs on the thread that changes them.
+    juce::uint32 lastVersion { 0 };
+    
+    // Evaluated only when the coefficients or the size change; paint just strokes the cached paths.
+    // Outside linked mode the second channel of the pair (right or side) gets a curve of its own.
+    std::array<ResponseCurve, 2> responseCurves;
+    std::array<juce::Path, 2> responseCurvePaths;
+    bool showsSecondChannel { false };
+    
+    void updateResponseCurve();
+    void updatePath();
+};
 
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override{}
-   
+// The processor's timing figures, over the response curve. Hidden until the editor's "Timing" button shows it.
+struct PerformanceOverlay: juce::Component, juce::Timer{
+    PerformanceOverlay(FirstEQAudioProcessor&);
+    
     void timerCallback() override;
+    void visibilityChanged() override;
     
     void paint(juce::Graphics &g) override;
+    void resized() override;
     
 private:
     FirstEQAudioProcessor& audioProcessor;
-    juce::Atomic<bool> parametersChanged {false};
-     
-    MonoChain monoChain;
+    
+    juce::TextButton saveButton { "Save Report" }, resetButton { "Reset" };
+    
+    // Refreshed by the timer, a few times a second, rather than on every paint.
+    juce::String report, status;
+    
+    void saveReport();
+};
+
+// One button per snapshot bank slot. Clicking one recalls it; with "Store" down, it stores into it instead.
+// Slots holding a snapshot are lit.
+struct SnapshotBar: juce::Component{
+    SnapshotBar(FirstEQAudioProcessor&);
+    
+    void resized() override;
+    
+private:
+    FirstEQAudioProcessor& audioProcessor;
+    
+    std::array<juce::TextButton, SnapshotBank::numSlots> slotButtons;
+    juce::TextButton storeButton { "Store" };
+    
+    void slotClicked(int slot);
+    void updateButtons();
+};
+
+// Edits one parametric band at a time: the selector picks the band, and the knobs and menus are
+// re-attached to that band's parameters.
+struct BandEditor: juce::Component{
+    BandEditor(FirstEQAudioProcessor&);
+    
+    void resized() override;
+    
+private:
+    FirstEQAudioProcessor& audioProcessor;
+    
+    juce::ComboBox bandSelector, typeBox, channelBox;
+    RotarySliderWithLabels freqSlider, gainSlider, qualitySlider;
+    
+    // Declared after the controls, so they're detached before the controls go.
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> freqAttachment, gainAttachment, qualityAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> typeAttachment, channelAttachment;
+    
+    void selectBand(int band);
+};
+
+// The settings that apply to the whole chain: a menu for each choice, and the morph amount.
+struct ChainOptionsBar: juce::Component{
+    ChainOptionsBar(FirstEQAudioProcessor&);
+    
+    void resized() override;
+    
+private:
+    static constexpr int numOptions = 6;
+    
+    std::array<juce::ComboBox, numOptions> optionBoxes;
+    juce::Slider morphSlider { juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight };
+    
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>, numOptions> optionAttachments;
+    juce::AudioProcessorValueTreeState::SliderAttachment morphAttachment;
 };
 
 //==============================================================================
@@ -77,13 +165,21 @@ private:
     // access the processor object that created it.
     FirstEQAudioProcessor& audioProcessor;
         
-    RotarySliderWithLabels   peakFreqSlider, peakGainSlider, peakQualitySlider, lowCutFreqSlider, highCutFreqSlider, lowCutSlopeSlider, highCutSlopeSlider;
+    RotarySliderWithLabels   lowCutFreqSlider, highCutFreqSlider, lowCutSlopeSlider, highCutSlopeSlider;
+    
+    BandEditor bandEditor;
+    ChainOptionsBar chainOptionsBar;
     
     ResponseCurveComponent responseCurveComponent;
     
+    juce::TextButton timingButton { "Timing" };
+    PerformanceOverlay performanceOverlay;
+    
+    SnapshotBar snapshotBar;
+    
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     
-    Attachment  peakFreqSliderAttachment, peakGainSliderAttachment, peakQualitySliderAttachment, lowCutFreqSliderAttachment, highCutFreqSliderAttachment, lowCutSlopeSliderAttachment, highCutSlopeSliderAttachment;
+    Attachment  lowCutFreqSliderAttachment, highCutFreqSliderAttachment, lowCutSlopeSliderAttachment, highCutSlopeSliderAttachment;
     
     
     
@@ -22,10 +22,21 @@ FirstEQAudioProcessor::FirstEQAudioProcessor()
                        )
 #endif
 {
+    for (auto* param : getParameters())
+        if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+            apvts.addParameterListener(withID->getParameterID(), this);
+    
+    coefficientDesigner.setListener(this);
+    coefficientDesigner.setDesignTiming(&performanceMonitor.design);
+    coefficientDesigner.setMorphParameters(apvts.getRawParameterValue("Morph"), apvts.getRawParameterValue("Morph Target"));
+    linearPhaseFilter.setEnabled(phaseMode->load() > 0.5f);
 }
 
 FirstEQAudioProcessor::~FirstEQAudioProcessor()
 {
+    for (auto* param : getParameters())
+        if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+            apvts.removeParameterListener(withID->getParameterID(), this);
 }
 
 //==============================================================================
@@ -63,7 +74,11 @@ bool FirstEQAudioProcessor::isMidiEffect() const
 
 double FirstEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // In linear-phase mode the FIR is the tail, otherwise it's however long the cascades ring for.
+    if (phaseMode->load() > 0.5f && getSampleRate() > 0.0)
+        return linearPhaseFilter.getTailLengthSamples() / getSampleRate();
+    
+    return coefficientDesigner.getTailLengthSeconds();
 }
 
 int FirstEQAudioProcessor::getNumPrograms()
@@ -96,18 +111,52 @@ void FirstEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBloc
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
     
-    juce::dsp::ProcessSpec spec;
+    auto numChannels = static_cast<size_t>(juce::jmax(1, getTotalNumOutputChannels()));
+    auto numGroups = (numChannels + SIMDFloat::size() - 1) / SIMDFloat::size();
+    auto numDoubleGroups = (numChannels + SIMDDouble::size() - 1) / SIMDDouble::size();
+    auto tileSize = juce::jmin(static_cast<size_t>(samplesPerBlock), maxTileSize);
+    
+    cascades.resize(numGroups);
+    doubleCascades.resize(numDoubleGroups);
     
-    spec.maximumBlockSize = samplesPerBlock;
+    for (auto& cascade : cascades)
+        cascade.prepare(tileSize);
+    for (auto& cascade : doubleCascades)
+        cascade.prepare(tileSize);
     
-    spec.numChannels = 1;
-     
-    spec.sampleRate = sampleRate;
+    interleaved = juce::dsp::AudioBlock<SIMDFloat>(interleavedData, numGroups, tileSize);
+    interleaved.clear();
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    doubleInterleaved = juce::dsp::AudioBlock<SIMDDouble>(doubleInterleavedData, numDoubleGroups, tileSize);
+    doubleInterleaved.clear();
+    
+    linearPhaseFilter.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), static_cast<juce::uint32>(numChannels) });
   
-    updateFilters();
+    // Only the set that runs gets the first coefficients (see updateFilters).
+    usingDoubleSections = filterPrecision->load() > 0.5f;
+    coefficientSmoother.prepare(sampleRate);
+    
+    // Also synthesises the first FIR, if linear phase is on, and loads it before the first block,
+    // so an offline render is the same every time.
+    coefficientDesigner.prepare(sampleRate, static_cast<int>(numChannels));
+    linearPhaseFilter.loadPendingImpulseResponse();
+    
+    if (coefficientDesigner.pullCoefficients()){
+        coefficientSmoother.reset(coefficientDesigner.getCoefficients());
+        updateFilters(coefficientDesigner.getCoefficients());
+    }
+    
+    for (auto& cascade : cascades)
+        cascade.reset();
+    for (auto& cascade : doubleCascades)
+        cascade.reset();
+    linearPhaseFilter.reset();
+    
+    preEQAnalyzer.prepare(sampleRate, getTotalNumInputChannels());
+    postEQAnalyzer.prepare(sampleRate, getTotalNumOutputChannels());
+    
+    usingLinearPhase = phaseMode->load() > 0.5f;
+    updateLatency();
 }
 
 void FirstEQAudioProcessor::releaseResources()
@@ -123,12 +172,9 @@ bool FirstEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel gets its own filter state, so any layout works: mono, stereo,
+    // surround, immersive or ambisonic.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
@@ -143,6 +189,61 @@ bool FirstEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 #endif
 
 void FirstEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Some offline hosts never set a rate; with none there's no budget, so the block isn't timed.
+    std::optional<PerformanceMonitor::ScopedTimer> timer;
+    
+    if (getSampleRate() > 0.0)
+        timer.emplace(performanceMonitor.processBlock, buffer.getNumSamples() / getSampleRate());
+    
+    // Both only copy into their FIFOs, and only while the editor is showing them.
+    preEQAnalyzer.push(buffer, getTotalNumInputChannels());
+    processBuffer(buffer);
+    postEQAnalyzer.push(buffer, getTotalNumOutputChannels());
+}
+
+void FirstEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Some offline hosts never set a rate; with none there's no budget, so the block isn't timed.
+    std::optional<PerformanceMonitor::ScopedTimer> timer;
+    
+    if (getSampleRate() > 0.0)
+        timer.emplace(performanceMonitor.processBlock, buffer.getNumSamples() / getSampleRate());
+    
+    // Both only copy into their FIFOs, and only while the editor is showing them.
+    preEQAnalyzer.push(buffer, getTotalNumInputChannels());
+    processBuffer(buffer);
+    postEQAnalyzer.push(buffer, getTotalNumOutputChannels());
+}
+
+bool FirstEQAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SIMDType>
+static bool areIdentity(const std::vector<OversampledCascade<SIMDType>>& groupCascades){
+    return std::all_of(groupCascades.begin(), groupCascades.end(), [](const auto& cascade){ return cascade.isIdentity(); });
+}
+
+// The first two channels become (L + R) * gain and (L - R) * gain: a gain of 0.5 encodes Mid/Side, and 1 decodes it again.
+template <typename SampleType>
+static void convertMidSide(const juce::dsp::AudioBlock<SampleType>& block, SampleType gain){
+    if (block.getNumChannels() < 2)
+        return;
+    
+    auto* first = block.getChannelPointer(0);
+    auto* second = block.getChannelPointer(1);
+    
+    for (size_t i = 0; i < block.getNumSamples(); ++i){
+        auto sum = (first[i] + second[i]) * gain;
+        second[i] = (first[i] - second[i]) * gain;
+        first[i] = sum;
+    }
+}
+
+template <typename SampleType>
+void FirstEQAudioProcessor::processBuffer(juce::AudioBuffer<SampleType>& buffer)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -158,22 +259,222 @@ void FirstEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce
         buffer.clear (i, 0, buffer.getNumSamples());
     
 
-    updateFilters();
+    // Designing happens on the designer thread; here we only pick up a finished set, if there is a new one,
+    // and ramp towards it.
+    if (coefficientDesigner.pullCoefficients()){
+        const auto& designed = coefficientDesigner.getCoefficients();
+        
+        // A new stereo mode changes what the channels of the pair carry, so there is nothing to ramp
+        // from: like a new phase mode, it starts from silence. The FIR switches when its own set
+        // for the mode is loaded (see handleAsyncUpdate).
+        if (designed.stereoMode != stereoMode){
+            coefficientSmoother.reset(designed);
+            updateFilters(designed);
+            
+            for (auto& cascade : cascades)
+                cascade.reset();
+            for (auto& cascade : doubleCascades)
+                cascade.reset();
+        }
+        else{
+            coefficientSmoother.setTarget(designed);
+        }
+    }
     
 
-    juce::dsp::AudioBlock<float> block(buffer);
+    // The set that wasn't running has stale coefficients and state, so it takes the running
+    // coefficients and starts again from silence.
+    auto useDoubleSections = filterPrecision->load() > 0.5f;
+    
+    if (useDoubleSections != usingDoubleSections){
+        usingDoubleSections = useDoubleSections;
+        updateFilters(coefficientSmoother.getCurrent());
+        
+        if (useDoubleSections)
+            for (auto& cascade : doubleCascades)
+                cascade.reset();
+        else
+            for (auto& cascade : cascades)
+                cascade.reset();
+    }
+    
+    auto numChannels = static_cast<size_t>(juce::jmin(buffer.getNumChannels(), totalNumOutputChannels));
+    juce::dsp::AudioBlock<SampleType> block(buffer.getArrayOfWritePointers(), numChannels, static_cast<size_t>(buffer.getNumSamples()));
+    
+    // Whichever mode is switched to starts from silence. The cascades skip any ramp that
+    // was left hanging while they weren't running.
+    auto useLinearPhase = phaseMode->load() > 0.5f;
+    
+    if (useLinearPhase != usingLinearPhase){
+        if (useLinearPhase){
+            linearPhaseFilter.reset();
+        }
+        else{
+            coefficientSmoother.reset(coefficientDesigner.getCoefficients());
+            updateFilters(coefficientDesigner.getCoefficients());
+            
+            for (auto& cascade : cascades)
+                cascade.reset();
+            for (auto& cascade : doubleCascades)
+                cascade.reset();
+        }
+        
+        usingLinearPhase = useLinearPhase;
+    }
+    
+    // Once the input is silent and the filters have stopped ringing, silence in gives silence out,
+    // so the block is passed straight through until the input has a signal in it again.
+    if (buffer.getMagnitude(0, buffer.getNumSamples()) > static_cast<SampleType>(silenceThreshold)){
+        silentSamples = 0;
+    }
+    else if (hasFinishedRinging()){
+        // Nothing is ringing to hear a ramp on, so the coefficients can jump straight to the target.
+        if (coefficientSmoother.isSmoothing()){
+            coefficientSmoother.reset(coefficientDesigner.getCoefficients());
+            updateFilters(coefficientDesigner.getCoefficients());
+        }
+        
+        return;
+    }
+    else{
+        silentSamples += buffer.getNumSamples();
+    }
+    
+    if (usingLinearPhase){
+        // The convolution's loop can't be reached into, so here Mid/Side takes a pass of its own each way.
+        // It follows the FIR that's loaded, which can be blocks behind the coefficients.
+        auto midSide = linearPhaseFilter.getStereoMode() == StereoMode_MidSide;
+        
+        if (midSide)
+            convertMidSide(block, static_cast<SampleType>(0.5));
+        
+        linearPhaseFilter.process(block);
+        
+        if (midSide)
+            convertMidSide(block, static_cast<SampleType>(1));
+        
+        return;
+    }
+    
+    // With every band neutral and nothing ramping or fading, the cascades would hand the audio
+    // back unchanged, so it isn't even interleaved.
+    if (! coefficientSmoother.isSmoothing() && (usingDoubleSections ? areIdentity(doubleCascades) : areIdentity(cascades)))
+        return;
     
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    for (size_t start = 0, numSamples = block.getNumSamples(); start < numSamples;){
+        auto length = juce::jmin(numSamples - start, interleaved.getNumSamples());
+        auto tile = block.getSubBlock(start, length);
+        
+        if (usingDoubleSections)
+            processTile(tile, doubleCascades, doubleInterleaved);
+        else
+            processTile(tile, cascades, interleaved);
+        
+        start += length;
+    }
+}
+
+// Channel c of source goes to lane c % numLanes of channel c / numLanes of destination. Unused lanes are fed silence.
+// With midSide, each pair of channels is encoded on the way: mid, (L + R) / 2, goes to the even lane and side, (L - R) / 2, to the odd one.
+template <typename SampleType, typename SIMDType>
+static void interleave(const juce::dsp::AudioBlock<SampleType>& source, const juce::dsp::AudioBlock<SIMDType>& destination, bool midSide){
+    using LaneType = typename SIMDType::ElementType;
+    constexpr auto numLanes = SIMDType::size();
+    constexpr auto half = static_cast<LaneType>(0.5);
+    auto numChannels = source.getNumChannels();
+    auto numSamples = source.getNumSamples();
     
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    for (size_t group = 0; group < destination.getNumChannels(); ++group){
+        auto* frames = reinterpret_cast<LaneType*>(destination.getChannelPointer(group));
+        
+        for (size_t lane = 0; lane < numLanes; ++lane){
+            auto channel = group * numLanes + lane;
+            
+            if (midSide && lane % 2 == 0 && channel + 1 < numChannels){
+                auto* left = source.getChannelPointer(channel);
+                auto* right = source.getChannelPointer(channel + 1);
+                
+                for (size_t i = 0; i < numSamples; ++i){
+                    auto l = static_cast<LaneType>(left[i]), r = static_cast<LaneType>(right[i]);
+                    frames[i * numLanes + lane] = (l + r) * half;
+                    frames[i * numLanes + lane + 1] = (l - r) * half;
+                }
+                
+                ++lane;
+            }
+            else if (channel < numChannels){
+                auto* samples = source.getChannelPointer(channel);
+                
+                for (size_t i = 0; i < numSamples; ++i)
+                    frames[i * numLanes + lane] = static_cast<LaneType>(samples[i]);
+            }
+            else{
+                for (size_t i = 0; i < numSamples; ++i)
+                    frames[i * numLanes + lane] = LaneType();
+            }
+        }
+    }
+}
+
+// The reverse of interleave(). With midSide, each pair is decoded on the way back: L = M + S, R = M - S.
+template <typename SampleType, typename SIMDType>
+static void deinterleave(const juce::dsp::AudioBlock<SIMDType>& source, const juce::dsp::AudioBlock<SampleType>& destination, bool midSide){
+    using LaneType = typename SIMDType::ElementType;
+    constexpr auto numLanes = SIMDType::size();
+    auto numChannels = destination.getNumChannels();
+    auto numSamples = destination.getNumSamples();
     
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    for (size_t channel = 0; channel < numChannels; ++channel){
+        const auto* frames = reinterpret_cast<const LaneType*>(source.getChannelPointer(channel / numLanes));
+        auto lane = channel % numLanes;
+        auto* samples = destination.getChannelPointer(channel);
+        
+        if (midSide && lane % 2 == 0 && channel + 1 < numChannels){
+            auto* right = destination.getChannelPointer(channel + 1);
+            
+            for (size_t i = 0; i < numSamples; ++i){
+                auto mid = frames[i * numLanes + lane], side = frames[i * numLanes + lane + 1];
+                samples[i] = static_cast<SampleType>(mid + side);
+                right[i] = static_cast<SampleType>(mid - side);
+            }
+            
+            ++channel;
+        }
+        else{
+            for (size_t i = 0; i < numSamples; ++i)
+                samples[i] = static_cast<SampleType>(frames[i * numLanes + lane]);
+        }
+    }
+}
+
+template <typename SampleType, typename SIMDType>
+void FirstEQAudioProcessor::processTile(const juce::dsp::AudioBlock<SampleType> &block, std::vector<OversampledCascade<SIMDType>>& groupCascades, const juce::dsp::AudioBlock<SIMDType>& scratch){
+    constexpr auto numLanes = SIMDType::size();
+    auto numGroups = juce::jmin(groupCascades.size(), (block.getNumChannels() + numLanes - 1) / numLanes);
     
+    auto groups = scratch.getSubsetChannelBlock(0, numGroups).getSubBlock(0, block.getNumSamples());
+    auto midSide = stereoMode == StereoMode_MidSide;
+    interleave(block, groups, midSide);
     
+    // While a ramp is running the tile is split on the smoother's control grid, otherwise it's processed in one go.
+    for (size_t start = 0, numSamples = groups.getNumSamples(); start < numSamples;){
+        auto length = numSamples - start;
+        
+        if (coefficientSmoother.isSmoothing()){
+            if (coefficientSmoother.isStepDue())
+                updateFilters(coefficientSmoother.step());
+            
+            length = juce::jmin(length, static_cast<size_t>(coefficientSmoother.getSamplesUntilNextStep()));
+            coefficientSmoother.advance(static_cast<int>(length));
+        }
+        
+        for (size_t group = 0; group < numGroups; ++group)
+            groupCascades[group].process(groups.getChannelPointer(group) + start, length);
+        
+        start += length;
+    }
     
+    deinterleave(groups, block.getSubsetChannelBlock(0, juce::jmin(block.getNumChannels(), numGroups * numLanes)), midSide);
 }
 
 //==============================================================================
@@ -195,92 +496,155 @@ void FirstEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
 
+    // Every parameter as a compact binary snapshot, then the snapshot bank (see ParameterSnapshot).
     juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    ParameterSnapshot(apvts).write(mos);
+    snapshotBank.write(mos);
 }
 
 void FirstEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+    ParameterSnapshot snapshot;
+    
+    // Nothing is designed here: the parameters and the bank's morph targets are only handed to the
+    // designer thread, which redesigns everything once it gets to them.
+    if (snapshot.read(stream)){
+        snapshot.apply(apvts);
+        snapshotBank.read(stream);
+        coefficientDesigner.markDirty(allBands);
+        return;
+    }
+    
+    // Sessions saved before snapshots hold the whole value tree.
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if(tree.isValid()){
         apvts.replaceState(tree);
-        updateFilters();
+        coefficientDesigner.markDirty(allBands);
     }
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState &apvts){
-    ChainSettings settings;
-    
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
-
-    return settings;
-}
-
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate){
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.peakFreq, chainSettings.peakQuality, juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+void FirstEQAudioProcessor::parameterChanged(const juce::String &parameterID, float){
+    if (parameterID.startsWith("LowCut"))
+        coefficientDesigner.markDirty(getBandMask(ChainPossitions::LowCut));
+    else if (parameterID.startsWith("HighCut"))
+        coefficientDesigner.markDirty(getBandMask(ChainPossitions::HighCut));
+    else if (parameterID.startsWith("Peak") || parameterID.startsWith("Band "))
+        coefficientDesigner.markDirty(getBandMask(ChainPossitions::Peak));
+    else if (parameterID == "Filter Design")
+        coefficientDesigner.markDirty(allBands);
+    else if (parameterID == "Stereo Mode")
+        coefficientDesigner.markDirty(getBandMask(ChainPossitions::Peak));
+    else if (parameterID == "Morph" || parameterID == "Morph Target")
+        coefficientDesigner.markMorphDirty();
+    else if (parameterID == "Oversampling"){
+        latencyChanged = true;
+        coefficientDesigner.markDirty(getBandMask(ChainPossitions::Peak) | getBandMask(ChainPossitions::HighCut));
+    }
+    else if (parameterID == "Phase Mode"){
+        // The FIR isn't kept up to date in minimum-phase mode, so switching on needs a fresh one.
+        latencyChanged = true;
+        coefficientDesigner.markDirty(allBands);
+    }
 }
 
-void FirstEQAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings){
-    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
+void FirstEQAudioProcessor::coefficientsDesigned(const CoefficientSnapshot& snapshot){
+    // The phase mode is picked up here rather than in parameterChanged, so the redesign it
+    // asked for reaches the FIR once it's enabled.
+    linearPhaseFilter.setEnabled(phaseMode->load() > 0.5f);
+    linearPhaseFilter.coefficientsDesigned(snapshot);
+    
+    if (linearPhaseFilter.isWaitingForLoad())
+        impulseResponseWaiting = true;
     
-    updateCoefficients(leftChain.get<ChainPossitions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPossitions::Peak>().coefficients, peakCoefficients);
+    // setLatencySamples() tells the host, which takes locks, so it's only ever called on the message thread.
+    // So is the FIR load, which needs the audio thread held off.
+    if (latencyChanged.exchange(false) || impulseResponseWaiting)
+        triggerAsyncUpdate();
 }
 
-void updateCoefficients(Coefficients &old, const Coefficients &replacements){
-    *old = *replacements;
+void FirstEQAudioProcessor::handleAsyncUpdate(){
+    // The convolutions can't crossfade into a FIR for another stereo mode, so it's loaded in the
+    // gap between two blocks and starts from silence, like the cascades do.
+    if (impulseResponseWaiting.exchange(false)){
+        suspendProcessing(true);
+        linearPhaseFilter.loadPendingImpulseResponse();
+        suspendProcessing(false);
+    }
+    
+    updateLatency();
 }
 
-void FirstEQAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings){
+bool FirstEQAudioProcessor::hasFinishedRinging() const noexcept{
+    // The convolution's state can't be looked at, so its tail is timed instead.
+    if (usingLinearPhase)
+        return silentSamples >= linearPhaseFilter.getTailLengthSamples();
     
-    auto cutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
+    auto hasDecayed = [](const auto& cascade){ return cascade.getStateMagnitude() <= silenceThreshold; };
     
-    auto& leftLowCut = leftChain.get<ChainPossitions::LowCut>();
-    auto& rightLowCut = rightChain.get<ChainPossitions::LowCut>();
-   
-    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
+    return usingDoubleSections ? std::all_of(doubleCascades.begin(), doubleCascades.end(), hasDecayed)
+                               : std::all_of(cascades.begin(), cascades.end(), hasDecayed);
 }
 
-void FirstEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings){
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
-    
-    auto& leftHighCut = leftChain.get<ChainPossitions::HighCut>();
-    auto& rightHighCut = rightChain.get<ChainPossitions::HighCut>();
-    
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+void FirstEQAudioProcessor::updateLatency(){
+    // The FIR already has the oversampled bands' response built in, so it never runs oversampled.
+    if (phaseMode->load() > 0.5f)
+        setLatencySamples(linearPhaseFilter.getLatencySamples());
+    else
+        setLatencySamples(HalfBand::getLatencySamples(1 << static_cast<int>(oversampling->load())));
 }
 
-void FirstEQAudioProcessor::updateFilters(){
-    auto chainSettings = getChainSettings(apvts);
+void FirstEQAudioProcessor::updateFilters(const ChainCoefficients &chainCoefficients){
+    // While ramping this runs once per control interval, so that's its budget. It's timed only once there's a rate.
+    std::optional<PerformanceMonitor::ScopedTimer> timer;
+    
+    if (getSampleRate() > 0.0)
+        timer.emplace(performanceMonitor.updateFilters, CoefficientSmoother::controlInterval / getSampleRate());
     
-    updateLowCutFilters(chainSettings);
-    updatePeakFilter(chainSettings);
-    updateHighCutFilters(chainSettings);
+    stereoMode = chainCoefficients.stereoMode;
+    
+    // Only the set that runs, so the control-rate cost is one set's whichever precision is picked. The
+    // other catches up from the smoother when "Filter Precision" switches to it.
+    if (usingDoubleSections)
+        for (auto& cascade : doubleCascades)
+            cascade.setCoefficients(chainCoefficients);
+    else
+        for (auto& cascade : cascades)
+            cascade.setCoefficients(chainCoefficients);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
 FirstEQAudioProcessor::createParameterLayout(){
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"LowCut Freq", 1}, "LowCutFreq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20.f));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"HighCut Freq", 1}, "HighCutFreq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.5f), 20000.f));
+    // Each cut is off at its default, the end of its range (see identityCoefficients).
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"LowCut Freq", 1}, "LowCutFreq", juce::NormalisableRange<float>(minCutFrequency, maxCutFrequency, 1.f, 0.25f), minCutFrequency));
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"Peak Freq", 1}, "PeakFreq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 750.f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"HighCut Freq", 1}, "HighCutFreq", juce::NormalisableRange<float>(minCutFrequency, maxCutFrequency, 1.f, 0.5f), maxCutFrequency));
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"Peak Gain", 1}, "PeakGain", juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
+    // The first band keeps the original "Peak" IDs, so existing sessions load as a single bell. The
+    // others start off, spread across the spectrum.
+    const juce::StringArray bandTypes { "Off", "Bell", "Low Shelf", "High Shelf", "Notch", "Low Cut", "High Cut" };
+    const juce::StringArray bandChannels { "Both", "Left / Mid", "Right / Side" };
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"Peak Quality", 1}, "PeakQuality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.9f), 1.f));
+    for (int band = 0; band < maxParametricBands; ++band){
+        auto name = getBandParameterID(band, "").removeCharacters(" ");
+        auto defaultFreq = band == 0 ? 750.f : juce::roundToInt(juce::mapToLog10((band - 0.5f) / (maxParametricBands - 1), 30.f, 15000.f));
+        auto defaultType = band == 0 ? BandType_Bell : BandType_Off;
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{getBandParameterID(band, "Freq"), 1}, name + "Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), defaultFreq));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{getBandParameterID(band, "Gain"), 1}, name + "Gain", juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{getBandParameterID(band, "Quality"), 1}, name + "Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.9f), 1.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{getBandParameterID(band, "Type"), 1}, name + "Type", bandTypes, defaultType));
+        
+        // Only read outside linked mode; see "Stereo Mode".
+        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{getBandParameterID(band, "Channel"), 1}, name + "Channel", bandChannels, BandChannel_Both));
+    }
     
     juce::StringArray stringArray;
     for (int i = 0; i < 4; ++i) {
@@ -294,6 +658,27 @@ FirstEQAudioProcessor::createParameterLayout(){
        
        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"HighCut Slope", 1}, "HighCutSlope", stringArray, 0));
        
+       // Float is cheapest. Double keeps low cuts near 20 Hz at high sample rates clean, and on
+       // double-precision hosts avoids converting the buffer at all.
+       layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Filter Precision", 1}, "FilterPrecision", juce::StringArray{"Float", "Double"}, 0));
+       
+       // Matched designs avoid cramping at 1x, with no extra CPU or latency; oversampling is the alternative.
+       layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Filter Design", 1}, "FilterDesign", juce::StringArray{"Bilinear", "Matched"}, 0));
+       
+       // Runs the peak and high cut at 2x or 4x, so high bells and cuts keep their analog shape near Nyquist.
+       layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Oversampling", 1}, "Oversampling", juce::StringArray{"Off", "2x", "4x"}, 0));
+       
+       // Linear phase keeps every band's phase flat at the cost of latency (half the FIR length).
+       layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Phase Mode", 1}, "PhaseMode", juce::StringArray{"Minimum", "Linear"}, 0));
+       
+       // On a stereo bus, Mid/Side and Dual Mono let each band's "Channel" put it on one side of the pair only.
+       layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Stereo Mode", 1}, "StereoMode", juce::StringArray{"Linked", "Mid/Side", "Dual Mono"}, 0));
+       
+       // Glides the running coefficients from the live settings towards a stored snapshot's (see SnapshotBank).
+       layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"Morph", 1}, "Morph", juce::NormalisableRange<float>(0.f, 1.f, 0.001f, 1.f), 0.f));
+       
+       layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Morph Target", 1}, "MorphTarget", juce::StringArray{"A", "B", "C", "D"}, 1));
+       
        return layout;
 }
 
@@ -9,88 +9,22 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilterChain.h"
+#include "CoefficientDesigner.h"
+#include "CoefficientSmoother.h"
+#include "OversampledCascade.h"
+#include "LinearPhaseFilter.h"
+#include "SpectrumAnalyzer.h"
+#include "PerformanceMonitor.h"
+#include "SnapshotBank.h"
 
 //==============================================================================
 /**
 */
-
-enum Slope{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-struct ChainSettings
-{
-    float peakFreq { 0 }, peakGainInDecibels{ 0 }, peakQuality {1.f};
-    float lowCutFreq { 0 }, highCutFreq { 0 };
-    
-    Slope lowCutSlope{ Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
-};
-
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState &apvts);
-
-
-using Filter = juce::dsp::IIR::Filter<float>;
-
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
-
-enum ChainPossitions{
-    LowCut,
-    Peak,
-    HighCut
-};
-
-using Coefficients = Filter::CoefficientsPtr;
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
-
-template<int Index, typename ChainType, typename CoefficientType>
-void update(ChainType& chain, const CoefficientType& coefficients){
-    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-    chain.template setBypassed<Index>(false);
-}
-
-template<typename ChainType, typename CoefficientType>
-void updateCutFilter(ChainType &chain, const CoefficientType coefficients, const Slope& slope)
-{
-    chain.template setBypassed<0>(true);
-    chain.template setBypassed<1>(true);
-    chain.template setBypassed<2>(true);
-    chain.template setBypassed<3>(true);
-    
-    switch(slope){
-        case Slope_48:
-        {
-            update<3>(chain, coefficients);
-        }
-        case Slope_36:
-        {
-            update<2>(chain, coefficients);
-        }
-        case Slope_24:
-        {
-            update<1>(chain, coefficients);
-        }
-        case Slope_12:
-        {
-            update<0>(chain, coefficients);
-        }
-    }
-}
-
-inline auto makeLowCutFilter(const ChainSettings chainSettings, double sampleRate){
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, sampleRate, 2 * (chainSettings.lowCutSlope + 1));
-}
-inline auto makeHighCutFilter(const ChainSettings chainSettings, double sampleRate){
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, sampleRate, 2 * (chainSettings.highCutSlope + 1));
-}
-
-
-class FirstEQAudioProcessor  : public juce::AudioProcessor
+class FirstEQAudioProcessor  : public juce::AudioProcessor,
+                               private juce::AudioProcessorValueTreeState::Listener,
+                               private CoefficientDesigner::Listener,
+                               private juce::AsyncUpdater
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -109,6 +43,9 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -137,19 +74,91 @@ public:
         createParameterLayout();
     
     juce::AudioProcessorValueTreeState apvts{*this, nullptr, "Parameters", createParameterLayout()};
+    
+    /** Message thread: the coefficients the processor is running (or ramping towards), for display. */
+    const CoefficientSnapshot& getCoefficientSnapshot() noexcept { return coefficientDesigner.getSnapshot(); }
+    
+    /** The spectrum going into and coming out of the EQ. */
+    SpectrumAnalyzer& getPreEQAnalyzer() noexcept { return preEQAnalyzer; }
+    SpectrumAnalyzer& getPostEQAnalyzer() noexcept { return postEQAnalyzer; }
+    
+    /** Always-on timing of processBlock, updateFilters and the designs, for the editor's overlay and reports. */
+    PerformanceMonitor& getPerformanceMonitor() noexcept { return performanceMonitor; }
+    
+    /** Message thread: the A/B/C/D snapshots, saved with the rest of the state. */
+    SnapshotBank& getSnapshotBank() noexcept { return snapshotBank; }
 
 private:
     
-    MonoChain leftChain, rightChain;
+    // Channels are processed in groups of SIMDFloat::size() (or SIMDDouble::size()), one
+    // channel per lane, with one cascade (and so one set of states) per group. The
+    // "Filter Precision" parameter picks which set runs, whatever precision the host uses.
+    std::vector<OversampledCascade<SIMDFloat>> cascades;
+    std::vector<OversampledCascade<SIMDDouble>> doubleCascades;
     
+    // Long blocks are processed in tiles of this many samples, so the interleaved
+    // scratch block and the audio it came from both stay in L1.
+    static constexpr size_t maxTileSize = 256;
     
-    void updatePeakFilter(const ChainSettings &chainSettings);
+    // Scratch blocks with one interleaved channel per group, sized in prepareToPlay.
+    juce::HeapBlock<char> interleavedData, doubleInterleavedData;
+    juce::dsp::AudioBlock<SIMDFloat> interleaved;
+    juce::dsp::AudioBlock<SIMDDouble> doubleInterleaved;
     
-    void updateLowCutFilters(const ChainSettings& chainSettings);
-    void updateHighCutFilters(const ChainSettings& chainSettings);
-
+    std::atomic<float>* filterPrecision = apvts.getRawParameterValue("Filter Precision");
+    bool usingDoubleSections { false };
+    
+    // In linear-phase mode the FIR replaces the cascades entirely. It is declared before
+    // the designer, which hands it each new set through the processor, so it is destroyed after it.
+    std::atomic<float>* phaseMode = apvts.getRawParameterValue("Phase Mode");
+    std::atomic<float>* oversampling = apvts.getRawParameterValue("Oversampling");
+    bool usingLinearPhase { false };
+    LinearPhaseFilter linearPhaseFilter;
+    
+    // Declared before the designer, which records into it from its own thread.
+    PerformanceMonitor performanceMonitor;
+    
+    ChainParameters chainParameters{apvts};
+    
+    CoefficientDesigner coefficientDesigner{chainParameters};
+    CoefficientSmoother coefficientSmoother;
+    
+    SnapshotBank snapshotBank{apvts, coefficientDesigner};
+    
+    // The mode the running coefficients were designed for. Interleaving encodes to Mid/Side,
+    // and deinterleaving decodes from it, in the same pass that moves the samples.
+    StereoMode stereoMode { StereoMode_Linked };
+    
+    SpectrumAnalyzer preEQAnalyzer, postEQAnalyzer;
+    
+    // Input at or below this (-160 dB) counts as silence, and so does filter state once it has decayed below it.
+    static constexpr double silenceThreshold = 1.0e-8;
+    
+    // Silent samples processed since the input last had a signal in it.
+    int silentSamples { 0 };
+    
+    bool hasFinishedRinging() const noexcept;
+    
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    
+    // Set when a parameter that moves the latency changes. Parameter callbacks can come on the audio thread,
+    // so they only set this; the designer thread then posts the update to the message thread.
+    std::atomic<bool> latencyChanged { false };
+    
+    // Set when the FIR has a set for a new stereo mode waiting, which only the message thread can load.
+    std::atomic<bool> impulseResponseWaiting { false };
+    
+    void coefficientsDesigned(const CoefficientSnapshot& snapshot) override;
+    void handleAsyncUpdate() override;
+    
+    void updateFilters(const ChainCoefficients& chainCoefficients);
+    void updateLatency();
+    
+    template <typename SampleType>
+    void processBuffer(juce::AudioBuffer<SampleType>& buffer);
     
-    void updateFilters();
+    template <typename SampleType, typename SIMDType>
+    void processTile(const juce::dsp::AudioBlock<SampleType>& block, std::vector<OversampledCascade<SIMDType>>& groupCascades, const juce::dsp::AudioBlock<SIMDType>& scratch);
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FirstEQAudioProcessor)
 };
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    PolyphaseOversampler.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PolyphaseOversampler.h"
+
+namespace HalfBand
+{
+    // Transition bands, as a fraction of the higher rate. The first stage keeps everything
+    // up to 0.46 of the host rate with about 99 dB of image rejection. The second only has
+    // to reject the first stage's images, so it can be much wider and shorter (about 117 dB).
+    constexpr double firstStageTransition = 0.04, secondStageTransition = 0.25;
+    
+    // Elliptic half-band design, after Valenzuela and Constantinides: the sums below are
+    // the theta-function series that place the allpass poles for a given transition band.
+    static double sumSeries(double q, int order, int c, bool numerator){
+        double sum = 0.0, term = 0.0;
+        int i = numerator ? 0 : 1;
+        double sign = numerator ? 1.0 : -1.0;
+        
+        do{
+            if (numerator)
+                term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * juce::MathConstants<double>::pi / order) * sign;
+            else
+                term = std::pow(q, i * i) * std::cos(i * 2 * c * juce::MathConstants<double>::pi / order) * sign;
+            
+            sum += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs(term) > 1e-100);
+        
+        return sum;
+    }
+    
+    static std::vector<double> design(int numCoefficients, double transition){
+        auto k = std::pow(std::tan((1.0 - transition * 2.0) * juce::MathConstants<double>::pi / 4.0), 2.0);
+        auto kk = std::pow(1.0 - k * k, 0.25);
+        auto e = 0.5 * (1.0 - kk) / (1.0 + kk);
+        auto e4 = std::pow(e, 4.0);
+        auto q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+        auto order = numCoefficients * 2 + 1;
+        
+        std::vector<double> coefficients;
+        
+        for (int c = 1; c <= numCoefficients; ++c){
+            auto ww = sumSeries(q, order, c, true) * std::pow(q, 0.25) / (sumSeries(q, order, c, false) + 0.5);
+            auto wwSquared = ww * ww;
+            auto x = std::sqrt((1.0 - wwSquared * k) * (1.0 - wwSquared / k)) / (1.0 + wwSquared);
+            coefficients.push_back((1.0 - x) / (1.0 + x));
+        }
+        
+        return coefficients;
+    }
+    
+    // Each first-order allpass (a + z^-1) / (1 + a z^-1) delays low frequencies by (1 - a) / (1 + a)
+    // samples at the lower rate. The half-sample offsets between the branches cancel over a
+    // round trip, since the downsampler reads each pair's later sample into the even branch.
+    static double getRoundTripDelay(const std::vector<double>& coefficients){
+        double delay = 0.0;
+        
+        for (auto a : coefficients)
+            delay += (1.0 - a) / (1.0 + a);
+        
+        return delay;
+    }
+    
+    const std::vector<double>& getFirstStageCoefficients(){
+        static const auto coefficients = design(firstStageSize, firstStageTransition);
+        return coefficients;
+    }
+    
+    const std::vector<double>& getSecondStageCoefficients(){
+        static const auto coefficients = design(secondStageSize, secondStageTransition);
+        return coefficients;
+    }
+    
+    int getLatencySamples(int factor){
+        // The second stage's lower rate is twice the host rate, so its delay counts half.
+        auto delay = 0.0;
+        
+        if (factor >= 2)
+            delay += getRoundTripDelay(getFirstStageCoefficients());
+        if (factor >= 4)
+            delay += getRoundTripDelay(getSecondStageCoefficients()) / 2.0;
+        
+        return juce::roundToInt(delay);
+    }
+}
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    PolyphaseOversampler.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+
+namespace HalfBand
+{
+    /** Allpass coefficients per stage; the first runs between 1x and 2x, the second between 2x and 4x. */
+    constexpr int firstStageSize = 8, secondStageSize = 4;
+    
+    const std::vector<double>& getFirstStageCoefficients();
+    const std::vector<double>& getSecondStageCoefficients();
+    
+    /** Round-trip (up, then down) group delay at low frequencies, in samples at the host rate. */
+    int getLatencySamples(int factor);
+}
+
+/**
+    One 2x polyphase IIR half-band stage: two branches of first-order allpasses,
+    each running at the lower of the two rates. Works on plain samples or on
+    SIMD registers of interleaved channels.
+*/
+template <typename SampleType, int NumCoefficients>
+class HalfBandStage
+{
+public:
+    static_assert(NumCoefficients % 2 == 0, "the coefficients alternate between the two branches");
+    
+    void setCoefficients(const std::vector<double>& newCoefficients) noexcept
+    {
+        jassert(newCoefficients.size() == static_cast<size_t>(NumCoefficients));
+        
+        for (int i = 0; i < NumCoefficients; ++i)
+            coefficients[i] = Helper::expand(static_cast<ElementType>(newCoefficients[static_cast<size_t>(i)]));
+    }
+    
+    void reset() noexcept
+    {
+        upState = {};
+        downState = {};
+    }
+    
+    /** The largest allpass state in either direction and any channel. */
+    double getStateMagnitude() const noexcept
+    {
+        ElementType result = 0;
+        
+        for (const auto* state : { &upState, &downState })
+            for (int i = 0; i < NumCoefficients; ++i)
+                result = juce::jmax(result, Helper::getMaxMagnitude(state->x[i]), Helper::getMaxMagnitude(state->y[i]));
+        
+        return static_cast<double>(result);
+    }
+    
+    /** Each input sample becomes two output samples. Each input is read before the outputs
+        at or after its index are written, so output may overlap the end of input. */
+    void upsample(const SampleType* input, SampleType* output, size_t numInputSamples) noexcept
+    {
+        auto state = upState;
+        
+        for (size_t i = 0; i < numInputSamples; ++i){
+            auto even = input[i], odd = even;
+            processBranches(even, odd, state);
+            output[2 * i] = even;
+            output[2 * i + 1] = odd;
+        }
+        
+        upState = state;
+    }
+    
+    /** Each pair of input samples becomes one output sample. Can run in place. */
+    void downsample(const SampleType* input, SampleType* output, size_t numOutputSamples) noexcept
+    {
+        auto state = downState;
+        const auto half = Helper::expand(static_cast<ElementType>(0.5));
+        
+        for (size_t i = 0; i < numOutputSamples; ++i){
+            auto even = input[2 * i + 1], odd = input[2 * i];
+            processBranches(even, odd, state);
+            output[i] = half * (even + odd);
+        }
+        
+        downState = state;
+    }
+    
+private:
+    using Helper = CascadeHelpers::Element<SampleType>;
+    using ElementType = typename Helper::Type;
+    
+    struct State
+    {
+        std::array<SampleType, NumCoefficients> x {}, y {};
+    };
+    
+    void processBranches(SampleType& even, SampleType& odd, State& state) const noexcept
+    {
+        for (int i = 0; i < NumCoefficients; i += 2){
+            auto nextEven = (even - state.y[i]) * coefficients[i] + state.x[i];
+            auto nextOdd = (odd - state.y[i + 1]) * coefficients[i + 1] + state.x[i + 1];
+            
+            state.x[i] = even;
+            state.x[i + 1] = odd;
+            state.y[i] = nextEven;
+            state.y[i + 1] = nextOdd;
+            
+            even = nextEven;
+            odd = nextOdd;
+        }
+    }
+    
+    std::array<SampleType, NumCoefficients> coefficients {};
+    State upState, downState;
+};
+
+/**
+    2x or 4x oversampling from cascaded half-band stages. They are IIR, so the
+    delay is far shorter than with linear-phase FIR half-bands, at the cost of a
+    little phase shift near the top of the audio band.
+*/
+template <typename SampleType>
+class PolyphaseOversampler
+{
+public:
+    static constexpr int maxFactor = 4;
+    
+    PolyphaseOversampler()
+    {
+        firstStage.setCoefficients(HalfBand::getFirstStageCoefficients());
+        secondStage.setCoefficients(HalfBand::getSecondStageCoefficients());
+    }
+    
+    /** 1, 2 or 4. Resets the stages, since their state belongs to the old rate. */
+    void setFactor(int newFactor) noexcept
+    {
+        jassert(newFactor == 1 || newFactor == 2 || newFactor == 4);
+        factor = newFactor;
+        reset();
+    }
+    
+    int getFactor() const noexcept { return factor; }
+    
+    void reset() noexcept
+    {
+        firstStage.reset();
+        secondStage.reset();
+    }
+    
+    /** The largest state in the stages in use; 0 at 1x, where none are. */
+    double getStateMagnitude() const noexcept
+    {
+        if (factor == 2)
+            return firstStage.getStateMagnitude();
+        if (factor == 4)
+            return juce::jmax(firstStage.getStateMagnitude(), secondStage.getStateMagnitude());
+        
+        return 0.0;
+    }
+    
+    /** Writes numSamples * getFactor() samples to output. */
+    void processUp(const SampleType* input, SampleType* output, size_t numSamples) noexcept
+    {
+        if (factor == 2){
+            firstStage.upsample(input, output, numSamples);
+        }
+        else if (factor == 4){
+            // The 2x signal sits in the second half of output, where the last stage can read it as it goes.
+            auto* twice = output + 2 * numSamples;
+            firstStage.upsample(input, twice, numSamples);
+            secondStage.upsample(twice, output, 2 * numSamples);
+        }
+    }
+    
+    /** Reads numSamples * getFactor() samples, overwriting them along the way. */
+    void processDown(SampleType* oversampled, SampleType* output, size_t numSamples) noexcept
+    {
+        if (factor == 2){
+            firstStage.downsample(oversampled, output, numSamples);
+        }
+        else if (factor == 4){
+            secondStage.downsample(oversampled, oversampled, 2 * numSamples);
+            firstStage.downsample(oversampled, output, numSamples);
+        }
+    }
+    
+private:
+    HalfBandStage<SampleType, HalfBand::firstStageSize> firstStage;
+    HalfBandStage<SampleType, HalfBand::secondStageSize> secondStage;
+    
+    int factor { 1 };
+};
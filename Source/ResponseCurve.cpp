@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+
+// |H(e^jw)|^2 of a normalised biquad, expanded into terms of cos(w) and cos(2w):
+// (n0 + n1 cos(w) + n2 cos(2w)) / (d0 + d1 cos(w) + d2 cos(2w)).
+struct SectionTerms
+{
+    double n0, n1, n2, d0, d1, d2;
+};
+
+static SectionTerms getSectionTerms(const BiquadCoefficients& c){
+    auto b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[4], a2 = c[5];
+
+    return {
+        b0 * b0 + b1 * b1 + b2 * b2, 2.0 * (b0 * b1 + b1 * b2), 2.0 * b0 * b2,
+        1.0 + a1 * a1 + a2 * a2, 2.0 * (a1 + a1 * a2), 2.0 * a2
+    };
+}
+
+void ResponseCurve::Grid::update(const std::vector<double>& frequencies, double newSampleRate){
+    sampleRate = newSampleRate;
+
+    cosW.resize(frequencies.size());
+    cos2W.resize(frequencies.size());
+
+    for (size_t i = 0; i < frequencies.size(); ++i){
+        auto w = juce::MathConstants<double>::twoPi * frequencies[i] / sampleRate;
+        cosW[i] = std::cos(w);
+        cos2W[i] = std::cos(2.0 * w);
+    }
+}
+
+bool ResponseCurve::Band::update(const BiquadCoefficients* newSections, int newNumSections, const Grid& newGrid){
+    bool unchanged = grid == &newGrid && numSections == newNumSections;
+
+    for (int i = 0; unchanged && i < newNumSections; ++i)
+        unchanged = sections[static_cast<size_t>(i)] == newSections[i];
+
+    if (unchanged)
+        return false;
+
+    grid = &newGrid;
+    numSections = newNumSections;
+    std::copy(newSections, newSections + newNumSections, sections.begin());
+
+    // Bands that are off don't change the curve, so they aren't evaluated at all.
+    power.clear();
+
+    if (std::all_of(sections.begin(), sections.begin() + numSections, [](const auto& s){ return isIdentity(s); }))
+        return true;
+
+    power.assign(newGrid.cosW.size(), 1.0);
+
+    auto* p = power.data();
+    const auto* c1 = newGrid.cosW.data();
+    const auto* c2 = newGrid.cos2W.data();
+    auto n = power.size();
+
+    for (int s = 0; s < numSections; ++s){
+        auto t = getSectionTerms(sections[static_cast<size_t>(s)]);
+
+        for (size_t i = 0; i < n; ++i)
+            p[i] *= (t.n0 + t.n1 * c1[i] + t.n2 * c2[i]) / (t.d0 + t.d1 * c1[i] + t.d2 * c2[i]);
+    }
+
+    return true;
+}
+
+void ResponseCurve::setNumPoints(int newNumPoints){
+    numPoints = juce::jmax(0, newNumPoints);
+
+    frequencies.resize(static_cast<size_t>(numPoints));
+
+    for (int i = 0; i < numPoints; ++i)
+        frequencies[static_cast<size_t>(i)] = juce::mapToLog10(static_cast<double>(i) / numPoints, minFrequency, maxFrequency);
+
+    // Forces both grids, and so every band, to be evaluated again.
+    hostGrid.sampleRate = oversampledGrid.sampleRate = 0.0;
+    decibels.assign(static_cast<size_t>(numPoints), 0.0f);
+}
+
+bool ResponseCurve::setCoefficients(const ChainCoefficients& coefficients, double sampleRate, int channel){
+    if (numPoints == 0 || sampleRate <= 0.0)
+        return false;
+
+    // A grid whose rate changed invalidates the bands evaluated on it.
+    auto updateGrid = [this](Grid& grid, double rate){
+        if (grid.sampleRate != rate){
+            grid.update(frequencies, rate);
+
+            auto invalidate = [&grid](Band& band){
+                if (band.grid == &grid)
+                    band.grid = nullptr;
+            };
+
+            invalidate(lowCut);
+            invalidate(highCut);
+            std::for_each(parametric.begin(), parametric.end(), invalidate);
+        }
+    };
+
+    updateGrid(hostGrid, sampleRate);
+    updateGrid(oversampledGrid, sampleRate * coefficients.oversamplingFactor);
+
+    const auto& sections = coefficients.parametric[static_cast<size_t>(channel)];
+
+    bool changed = lowCut.update(coefficients.lowCut.data(), coefficients.lowCutSlope + 1, hostGrid);
+    changed |= highCut.update(coefficients.highCut.data(), coefficients.highCutSlope + 1, oversampledGrid);
+
+    for (size_t band = 0; band < parametric.size(); ++band)
+        changed |= parametric[band].update(&sections[band], 1, oversampledGrid);
+
+    if (! changed)
+        return false;
+
+    product.assign(decibels.size(), 1.0);
+
+    auto multiply = [this](const Band& band){
+        if (band.power.empty())
+            return;
+
+        auto* p = product.data();
+        const auto* b = band.power.data();
+
+        for (size_t i = 0; i < product.size(); ++i)
+            p[i] *= b[i];
+    };
+
+    multiply(lowCut);
+    multiply(highCut);
+    std::for_each(parametric.begin(), parametric.end(), multiply);
+
+    // One log per point for the whole chain. The power is 10 log10, not 20, and is kept
+    // in double because a steep cut a few decades out is far below float's range.
+    for (size_t i = 0; i < decibels.size(); ++i)
+        decibels[i] = static_cast<float>(10.0 * std::log10(juce::jmax(product[i], 1.0e-30)));
+
+    return true;
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+
+/**
+    The magnitude response of a ChainCoefficients set, sampled at a fixed set of
+    log-spaced frequencies for drawing.
+
+    cos(w) and cos(2w) are worked out once per point and per rate, whenever the
+    number of points or the rate changes, and each section is reduced to the six
+    terms of its squared magnitude in those two. A section then costs a couple of
+    multiply-adds and a divide per point, in a plain loop the compiler vectorises,
+    with no complex maths and no log per section.
+
+    Each cut and each parametric band keeps its own squared response, keyed by
+    the sections it was evaluated for, and only those whose sections actually
+    changed are evaluated again; the curve is the product of the cached ones.
+    Dragging one band re-evaluates just that band.
+*/
+class ResponseCurve
+{
+public:
+    static constexpr double minFrequency = 20.0, maxFrequency = 20000.0;
+
+    /** Lays out a new frequency grid; every band is evaluated again on the next setCoefficients(). */
+    void setNumPoints(int newNumPoints);
+
+    int getNumPoints() const noexcept { return numPoints; }
+
+    /** Evaluates the bands whose sections or rate changed, with the parametric bands of the given
+        channel of the pair (see ChainCoefficients::parametric). Returns true if the curve changed.
+    */
+    bool setCoefficients(const ChainCoefficients& coefficients, double sampleRate, int channel = 0);
+
+    /** The whole chain's gain at each point, in decibels. */
+    const std::vector<float>& getDecibels() const noexcept { return decibels; }
+
+private:
+    // cos(w) and cos(2w) at each point, for one sample rate.
+    struct Grid
+    {
+        std::vector<double> cosW, cos2W;
+        double sampleRate { 0.0 };
+
+        void update(const std::vector<double>& frequencies, double newSampleRate);
+    };
+
+    // The squared response of one cut or parametric band at each point, and the sections it was evaluated for.
+    // A band whose sections are all identity leaves power empty, and is left out of the product.
+    struct Band
+    {
+        std::vector<double> power;
+        CutCoefficients sections {};
+        int numSections { -1 };
+        const Grid* grid { nullptr };
+
+        bool update(const BiquadCoefficients* newSections, int newNumSections, const Grid& newGrid);
+    };
+
+    int numPoints { 0 };
+    std::vector<double> frequencies;
+
+    // The low cut runs at the host rate, the parametric bands and high cut at the oversampled one.
+    Grid hostGrid, oversampledGrid;
+    Band lowCut, highCut;
+    std::array<Band, maxParametricBands> parametric;
+
+    // The cached bands multiplied together, before the log.
+    std::vector<double> product;
+    std::vector<float> decibels;
+};
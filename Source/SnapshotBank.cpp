@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    SnapshotBank.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SnapshotBank.h"
+
+const juce::StringArray& SnapshotBank::getUnstoredParameterIDs(){
+    static const juce::StringArray ids { "Morph", "Morph Target" };
+    return ids;
+}
+
+SnapshotBank::SnapshotBank(juce::AudioProcessorValueTreeState& s, CoefficientDesigner& d) : apvts(s), designer(d){
+}
+
+void SnapshotBank::store(int slot){
+    slots[static_cast<size_t>(slot)] = ParameterSnapshot(apvts, getUnstoredParameterIDs());
+    updateMorphTarget(slot);
+}
+
+void SnapshotBank::recall(int slot){
+    const auto& snapshot = slots[static_cast<size_t>(slot)];
+
+    if (snapshot.isEmpty())
+        return;
+
+    // Setting the parameters flags their bands for redesign; publishing the slot's design clears them again.
+    snapshot.apply(apvts);
+    designer.recallMorphTarget(slot);
+}
+
+void SnapshotBank::updateMorphTarget(int slot){
+    const auto& snapshot = slots[static_cast<size_t>(slot)];
+
+    if (snapshot.isEmpty()){
+        designer.setMorphTarget(slot, std::nullopt);
+        return;
+    }
+
+    // The slot's values, laid out like the live ones, read through a ChainParameters just as the live ones are.
+    const auto& parameters = apvts.processor.getParameters();
+    std::vector<std::atomic<float>> values(static_cast<size_t>(parameters.size()));
+
+    for (int i = 0; i < parameters.size(); ++i)
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameters[i]))
+            values[static_cast<size_t>(i)] = snapshot.getValue(*ranged, i);
+
+    ChainParameters slotParameters([this, &values](const juce::String& parameterID){
+        return &values[static_cast<size_t>(apvts.getParameter(parameterID)->getParameterIndex())];
+    });
+
+    designer.setMorphTarget(slot, getChainSettings(slotParameters));
+}
+
+void SnapshotBank::write(juce::OutputStream& stream) const{
+    stream.writeInt(numSlots);
+
+    for (const auto& snapshot : slots){
+        stream.writeBool(! snapshot.isEmpty());
+
+        if (! snapshot.isEmpty())
+            snapshot.write(stream);
+    }
+}
+
+bool SnapshotBank::read(juce::InputStream& stream){
+    for (auto& snapshot : slots)
+        snapshot = {};
+
+    auto numStored = stream.readInt();
+    auto complete = numStored > 0;
+
+    for (int i = 0; complete && i < numStored; ++i){
+        ParameterSnapshot snapshot;
+
+        if (stream.readBool())
+            complete = snapshot.read(stream);
+
+        if (i < numSlots)
+            slots[static_cast<size_t>(i)] = std::move(snapshot);
+    }
+
+    if (! complete)
+        for (auto& snapshot : slots)
+            snapshot = {};
+
+    for (int slot = 0; slot < numSlots; ++slot)
+        updateMorphTarget(slot);
+
+    return complete;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    SnapshotBank.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+#include "CoefficientDesigner.h"
+
+/**
+    Four slots, A to D, each holding a ParameterSnapshot.
+
+    Each slot's settings are also a morph target (see CoefficientDesigner),
+    which the designer thread designs when a slot is stored or loaded, or when
+    the rate changes. So the "Morph" parameter glides from the live settings
+    towards a stored slot without any redesigns at all, and recalling a slot
+    hands the designer a finished set. The audio thread ramps to it as it
+    would to any new set.
+
+    Everything here runs on the message thread, and nothing here designs.
+*/
+class SnapshotBank
+{
+public:
+    static constexpr int numSlots = CoefficientDesigner::numMorphTargets;
+
+    /** The parameters a slot doesn't store or recall, so recalling one never moves the morph. */
+    static const juce::StringArray& getUnstoredParameterIDs();
+
+    SnapshotBank(juce::AudioProcessorValueTreeState& apvts, CoefficientDesigner& designer);
+
+    bool isStored(int slot) const noexcept { return ! slots[static_cast<size_t>(slot)].isEmpty(); }
+
+    /** Captures the current parameters into a slot, replacing whatever was there. */
+    void store(int slot);
+
+    /** Sets the parameters to a slot's values and publishes its design. Does nothing if the slot is empty. */
+    void recall(int slot);
+
+    void write(juce::OutputStream& stream) const;
+
+    /** Replaces every slot with those in the stream. Returns false, leaving the bank empty, if there aren't any. */
+    bool read(juce::InputStream& stream);
+
+private:
+    // Hands a slot's settings to the designer as its morph target.
+    void updateMorphTarget(int slot);
+
+    juce::AudioProcessorValueTreeState& apvts;
+    CoefficientDesigner& designer;
+
+    std::array<ParameterSnapshot, numSlots> slots;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SnapshotBank)
+};
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+SpectrumAnalyzerThread::SpectrumAnalyzerThread() : juce::Thread("FirstEQ Spectrum Analyzer"){
+    startThread();
+}
+
+SpectrumAnalyzerThread::~SpectrumAnalyzerThread(){
+    stopThread(1000);
+}
+
+void SpectrumAnalyzerThread::addAnalyzer(SpectrumAnalyzer* analyzer){
+    const juce::ScopedLock sl(lock);
+    analyzers.add(analyzer);
+}
+
+void SpectrumAnalyzerThread::removeAnalyzer(SpectrumAnalyzer* analyzer){
+    const juce::ScopedLock sl(lock);
+    analyzers.removeFirstMatchingValue(analyzer);
+}
+
+void SpectrumAnalyzerThread::run(){
+    while (! threadShouldExit()){
+        {
+            const juce::ScopedLock sl(lock);
+
+            for (auto* analyzer : analyzers)
+                analyzer->analyse();
+        }
+
+        wait(pollIntervalMs);
+    }
+}
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer(){
+    analyzerThread->addAnalyzer(this);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer(){
+    analyzerThread->removeAnalyzer(this);
+}
+
+void SpectrumAnalyzer::prepare(double newSampleRate, int numChannels){
+    const juce::ScopedLock sl(lock);
+
+    sampleRate = newSampleRate;
+
+    // About 12 Hz per bin whatever the rate, so the low end resolves just as well at 192 kHz.
+    auto order = juce::jlimit(11, 14, 12 + juce::roundToInt(std::log2(sampleRate / 48000.0)));
+
+    fft = std::make_unique<juce::dsp::FFT>(order);
+    fftSize = 1 << order;
+    hopSize = fftSize / 4;
+
+    frame.assign(static_cast<size_t>(fftSize), 0.0f);
+    fftData.assign(static_cast<size_t>(fftSize) * 2, 0.0f);
+
+    window.resize(static_cast<size_t>(fftSize));
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), static_cast<size_t>(fftSize),
+                                                             juce::dsp::WindowingFunction<float>::hann, false);
+
+    // A full-scale sine reads 0 dB: the window's sum, halved for the one-sided spectrum.
+    auto windowSum = std::accumulate(window.begin(), window.end(), 0.0f);
+    windowGain = 2.0f / windowSum;
+
+    // A quarter of a second of headroom, so the analyzer can fall well behind before anything is dropped.
+    auto fifoSize = juce::nextPowerOfTwo(juce::jmax(fftSize * 2, static_cast<int>(sampleRate / 4)));
+    fifoBuffer.setSize(juce::jmax(1, numChannels), fifoSize);
+    fifoBuffer.clear();
+    fifo.setTotalSize(fifoSize);
+
+    auto numBins = fftSize / 2 + 1;
+    auto binWidth = sampleRate / fftSize;
+
+    for (int i = 0; i < numPoints; ++i){
+        auto lower = juce::mapToLog10((i - 0.5) / (numPoints - 1), minFrequency, maxFrequency) / binWidth;
+        auto upper = juce::mapToLog10((i + 0.5) / (numPoints - 1), minFrequency, maxFrequency) / binWidth;
+        auto centre = juce::mapToLog10(static_cast<double>(i) / (numPoints - 1), minFrequency, maxFrequency) / binWidth;
+
+        binStarts[static_cast<size_t>(i)] = juce::jlimit(0, numBins - 1, static_cast<int>(std::ceil(lower)));
+        binEnds[static_cast<size_t>(i)] = juce::jlimit(0, numBins, static_cast<int>(std::ceil(upper)));
+        binCentres[static_cast<size_t>(i)] = static_cast<float>(juce::jmin(centre, static_cast<double>(numBins - 2)));
+    }
+
+    levels.fill(minDecibels);
+}
+
+void SpectrumAnalyzer::setActive(bool shouldBeActive){
+    const juce::ScopedLock sl(lock);
+
+    if (shouldBeActive == active.load())
+        return;
+
+    // The audio thread isn't writing while the analyzer is off, so the FIFO can be emptied
+    // before it starts again, and the first frame isn't made of stale audio.
+    if (shouldBeActive){
+        fifo.reset();
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        levels.fill(minDecibels);
+    }
+
+    active = shouldBeActive;
+}
+
+void SpectrumAnalyzer::analyse(){
+    const juce::ScopedLock sl(lock);
+
+    if (! active.load() || fft == nullptr)
+        return;
+
+    // Only the last frame's worth of a backlog can show up in the spectrum, so the rest is skipped unread.
+    auto numReady = fifo.getNumReady();
+
+    if (numReady > fftSize){
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(numReady - fftSize, start1, size1, start2, size2);
+        fifo.finishedRead(size1 + size2);
+    }
+
+    bool analysed = false;
+
+    while (fifo.getNumReady() >= hopSize){
+        std::copy(frame.begin() + hopSize, frame.end(), frame.begin());
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(hopSize, start1, size1, start2, size2);
+
+        // The channels are summed here rather than on the audio thread; analyseFrame() scales the sum.
+        auto* destination = frame.data() + (fftSize - hopSize);
+        auto numChannels = juce::jlimit(1, fifoBuffer.getNumChannels(), numChannelsPushed.load(std::memory_order_relaxed));
+
+        std::copy_n(fifoBuffer.getReadPointer(0, start1), size1, destination);
+        std::copy_n(fifoBuffer.getReadPointer(0, start2), size2, destination + size1);
+
+        for (int channel = 1; channel < numChannels; ++channel){
+            juce::FloatVectorOperations::add(destination, fifoBuffer.getReadPointer(channel, start1), size1);
+            juce::FloatVectorOperations::add(destination + size1, fifoBuffer.getReadPointer(channel, start2), size2);
+        }
+
+        fifo.finishedRead(size1 + size2);
+
+        analyseFrame();
+        analysed = true;
+    }
+
+    if (analysed)
+        publishPath();
+}
+
+void SpectrumAnalyzer::analyseFrame(){
+    juce::FloatVectorOperations::multiply(fftData.data(), frame.data(), window.data(), fftSize);
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    auto gain = windowGain / static_cast<float>(numChannelsPushed.load(std::memory_order_relaxed));
+    auto release = releaseDecibelsPerSecond * static_cast<float>(hopSize / sampleRate);
+
+    for (size_t i = 0; i < static_cast<size_t>(numPoints); ++i){
+        float magnitude;
+
+        // Where a point spans several bins it shows the loudest, so narrow peaks aren't averaged away.
+        if (binEnds[i] - binStarts[i] > 1){
+            magnitude = *std::max_element(fftData.begin() + binStarts[i], fftData.begin() + binEnds[i]);
+        }
+        else{
+            auto bin = static_cast<int>(binCentres[i]);
+            auto fraction = binCentres[i] - static_cast<float>(bin);
+            magnitude = fftData[static_cast<size_t>(bin)] + fraction * (fftData[static_cast<size_t>(bin) + 1] - fftData[static_cast<size_t>(bin)]);
+        }
+
+        auto level = juce::Decibels::gainToDecibels(magnitude * gain, minDecibels);
+        levels[i] = juce::jmax(level, levels[i] - release);
+    }
+}
+
+void SpectrumAnalyzer::publishPath(){
+    auto& path = paths.getWriteBuffer();
+
+    // Clearing keeps the path's storage, so after the first few frames this doesn't allocate.
+    path.clear();
+    path.preallocateSpace(numPoints * 3 + 12);
+
+    auto map = [](float level){
+        return juce::jmap(juce::jlimit(minDecibels, maxDecibels, level), minDecibels, maxDecibels, 1.0f, 0.0f);
+    };
+
+    path.startNewSubPath(0.0f, 1.0f);
+
+    for (int i = 0; i < numPoints; ++i)
+        path.lineTo(static_cast<float>(i) / (numPoints - 1), map(levels[static_cast<size_t>(i)]));
+
+    path.lineTo(1.0f, 1.0f);
+    path.closeSubPath();
+
+    paths.publish();
+}
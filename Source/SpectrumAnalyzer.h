@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+class SpectrumAnalyzer;
+
+/**
+    One background thread, shared by every plugin instance in the process, that
+    runs the FFTs and builds the paths for every active SpectrumAnalyzer.
+*/
+class SpectrumAnalyzerThread : public juce::Thread
+{
+public:
+    SpectrumAnalyzerThread();
+    ~SpectrumAnalyzerThread() override;
+
+    void addAnalyzer(SpectrumAnalyzer* analyzer);
+    void removeAnalyzer(SpectrumAnalyzer* analyzer);
+
+    void run() override;
+
+private:
+    // About one display frame. The audio thread never wakes this thread, so it polls.
+    static constexpr int pollIntervalMs = 15;
+
+    juce::CriticalSection lock;
+    juce::Array<SpectrumAnalyzer*> analyzers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzerThread)
+};
+
+/**
+    The spectrum of one tap in the signal path, for drawing behind the response curve.
+
+    The audio thread only copies its block's channels into a wait-free FIFO, one
+    channel each, and only while an editor is showing the analyzer. Summing them
+    to mono, windowing, the FFT, binning onto a log-frequency axis, smoothing and
+    building the path all happen on the analyzer thread, in buffers allocated by
+    prepare(). The finished path reaches
+    the editor through a triple buffer.
+*/
+class SpectrumAnalyzer
+{
+public:
+    /** Points along the log-frequency axis, from minFrequency to maxFrequency. */
+    static constexpr int numPoints = 256;
+    static constexpr double minFrequency = 20.0, maxFrequency = 20000.0;
+
+    /** The range the path's y axis spans, top to bottom. */
+    static constexpr float maxDecibels = 6.0f, minDecibels = -90.0f;
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer();
+
+    /** Message thread, while the audio thread isn't pushing: sizes the FFT and FIFO for the new rate and channel count. */
+    void prepare(double sampleRate, int numChannels);
+
+    /** Message thread: the audio thread only pushes while an editor has turned the analyzer on. */
+    void setActive(bool shouldBeActive);
+
+    /** Audio thread, wait-free: copies the first numChannels channels into the FIFO, as they are. */
+    template <typename SampleType>
+    void push(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept;
+
+    /** Message thread, wait-free: takes the newest path, returning false if there is none. */
+    bool pullPath() noexcept { return paths.acquire(); }
+
+    /** Message thread: the path taken by the last successful pullPath(). It's closed along the
+        bottom, in a unit square: x from 0 to 1 across the frequencies, y from 0 (maxDecibels) to 1 (minDecibels).
+    */
+    const juce::Path& getPath() const noexcept { return paths.getReadBuffer(); }
+
+private:
+    friend class SpectrumAnalyzerThread;
+
+    // How fast a peak falls back when the level drops.
+    static constexpr float releaseDecibelsPerSecond = 60.0f;
+
+    void analyse();
+    void analyseFrame();
+    void publishPath();
+
+    template <typename SampleType>
+    void writeToFifo(const juce::AudioBuffer<SampleType>& buffer, int numChannels, int sourceStart, int fifoStart, int numSamples) noexcept;
+
+    std::atomic<bool> active { false };
+    std::atomic<int> numChannelsPushed { 1 };
+
+    // Held by the analyzer thread while analysing and by prepare() and setActive(), never by the audio thread.
+    juce::CriticalSection lock;
+
+    // One channel per channel pushed, all read and written at the same positions.
+    juce::AbstractFifo fifo { 1 };
+    juce::AudioBuffer<float> fifoBuffer;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    int fftSize { 0 }, hopSize { 0 };
+    double sampleRate { 0 };
+
+    std::vector<float> frame, window, fftData;
+    float windowGain { 1.0f };
+
+    // Each point covers the FFT bins [binStarts[i], binEnds[i]), or is read off between two bins at binCentres[i]
+    // where the points are closer together than the bins.
+    std::array<int, numPoints> binStarts {}, binEnds {};
+    std::array<float, numPoints> binCentres {};
+    std::array<float, numPoints> levels {};
+
+    TripleBuffer<juce::Path> paths;
+
+    juce::SharedResourcePointer<SpectrumAnalyzerThread> analyzerThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
+
+//==============================================================================
+template <typename SampleType>
+void SpectrumAnalyzer::push(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept{
+    if (! active.load(std::memory_order_relaxed) || numChannels <= 0 || fifoBuffer.getNumSamples() == 0)
+        return;
+
+    numChannels = juce::jmin(numChannels, buffer.getNumChannels(), fifoBuffer.getNumChannels());
+    numChannelsPushed.store(numChannels, std::memory_order_relaxed);
+
+    // If the analyzer has fallen behind, the rest of the block is dropped. It only ever
+    // shows the most recent frame anyway.
+    auto numSamples = juce::jmin(buffer.getNumSamples(), fifo.getFreeSpace());
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    writeToFifo(buffer, numChannels, 0, start1, size1);
+    writeToFifo(buffer, numChannels, size1, start2, size2);
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+template <typename SampleType>
+void SpectrumAnalyzer::writeToFifo(const juce::AudioBuffer<SampleType>& buffer, int numChannels, int sourceStart, int fifoStart, int numSamples) noexcept{
+    if (numSamples <= 0)
+        return;
+
+    for (int channel = 0; channel < numChannels; ++channel){
+        auto* destination = fifoBuffer.getWritePointer(channel, fifoStart);
+        const auto* source = buffer.getReadPointer(channel, sourceStart);
+
+        if constexpr (std::is_same_v<SampleType, float>){
+            juce::FloatVectorOperations::copy(destination, source, numSamples);
+        }
+        else{
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = static_cast<float>(source[i]);
+        }
+    }
+}
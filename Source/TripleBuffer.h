@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Wait-free single-producer / single-consumer handoff of complete values.
+
+    The producer fills getWriteBuffer() and calls publish(); the consumer calls
+    acquire() and, if it returns true, reads the newest value from getReadBuffer().
+    Neither side ever blocks, and each side only ever touches its own slot, so a
+    value is never read while it is half written.
+*/
+template <typename ValueType>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    /** Producer side: the slot to fill before calling publish(). */
+    ValueType& getWriteBuffer() noexcept { return buffers[static_cast<size_t>(writeIndex)]; }
+
+    /** Producer side: hands the write slot over and takes the spare one back. */
+    void publish() noexcept
+    {
+        writeIndex = spare.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /** Consumer side: swaps in the newest published value, if there is one. */
+    bool acquire() noexcept
+    {
+        if ((spare.load(std::memory_order_relaxed) & freshFlag) == 0)
+            return false;
+
+        readIndex = spare.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    /** Consumer side: the value taken by the last successful acquire(). */
+    const ValueType& getReadBuffer() const noexcept { return buffers[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int indexMask = 3, freshFlag = 4;
+
+    std::array<ValueType, 3> buffers {};
+    int writeIndex = 0, readIndex = 1;
+    std::atomic<int> spare { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};